@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+// allocationtracker.cpp
+// ============
+// count heap allocations made while rendering each frame
+///////////////////////////////////////////////////////////////////////////////
+
+#include "AllocationTracker.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// declaration of global variables
+namespace
+{
+	// each thread has its own count, and only the render thread
+	// that called BeginFrame() adds to it
+	thread_local bool g_bRenderThread = false;
+	thread_local unsigned long long g_FrameAllocations = 0;
+	unsigned int g_FrameNumber = 0;
+	// frame of the last report, and the allocating frames not
+	// reported since then
+	unsigned int g_LastReportFrame = 0;
+	unsigned int g_UnreportedFrames = 0;
+}
+
+#ifdef _DEBUG
+/***********************************************************
+ *  operator new / operator delete
+ *
+ *  Replacements for the global allocation functions that
+ *  count every heap allocation made by the render thread.
+ ***********************************************************/
+void* operator new(std::size_t size)
+{
+	if (g_bRenderThread)
+	{
+		g_FrameAllocations++;
+	}
+	void* pMemory = std::malloc(size ? size : 1);
+	if (pMemory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return(pMemory);
+}
+
+void* operator new[](std::size_t size)
+{
+	return(operator new(size));
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete(void* pMemory, std::size_t) noexcept
+{
+	std::free(pMemory);
+}
+
+void operator delete[](void* pMemory, std::size_t) noexcept
+{
+	std::free(pMemory);
+}
+#endif
+
+/***********************************************************
+ *  BeginFrame()
+ ***********************************************************/
+void AllocationTracker::BeginFrame()
+{
+	g_bRenderThread = true;
+	g_FrameAllocations = 0;
+}
+
+/***********************************************************
+ *  EndFrame()
+ ***********************************************************/
+void AllocationTracker::EndFrame()
+{
+#ifdef _DEBUG
+	g_FrameNumber++;
+
+	unsigned long long allocations = GetFrameAllocations();
+	if ((g_FrameNumber <= WARMUP_FRAMES) || (allocations == 0))
+	{
+		return;
+	}
+
+	if ((g_LastReportFrame != 0) && (g_FrameNumber - g_LastReportFrame < REPORT_INTERVAL_FRAMES))
+	{
+		g_UnreportedFrames++;
+		return;
+	}
+
+	std::cerr << "ERROR: frame " << g_FrameNumber << " made " << allocations
+		<< " heap allocations, steady-state frames should make none";
+	if (g_UnreportedFrames > 0)
+	{
+		std::cerr << " (" << g_UnreportedFrames << " more frames allocated since the last report)";
+	}
+	std::cerr << std::endl;
+	g_LastReportFrame = g_FrameNumber;
+	g_UnreportedFrames = 0;
+#endif
+}
+
+/***********************************************************
+ *  GetFrameAllocations()
+ ***********************************************************/
+unsigned long long AllocationTracker::GetFrameAllocations()
+{
+	return(g_FrameAllocations);
+}
@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////
+// allocationtracker.h
+// ============
+// count heap allocations made while rendering each frame
+//
+//  Only active in debug builds, where the global operator new is
+//  replaced with a counting version.  In release builds nothing is
+//  counted, BeginFrame() only clears the count and EndFrame() does
+//  nothing.
+//
+//  Only the thread that calls BeginFrame() is counted, so the
+//  allocations of worker threads such as the frame capture writer
+//  and the image decoders are not reported as frame allocations.
+//  All of the functions must be called from that render thread.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace AllocationTracker
+{
+	// number of frames to skip before allocations are reported
+	const unsigned int WARMUP_FRAMES = 60;
+	// fewest frames between two reports, so a frame loop that
+	// keeps allocating does not flood the output
+	const unsigned int REPORT_INTERVAL_FRAMES = 60;
+
+	// reset the allocation count at the start of a frame, and
+	// count the allocations of the calling thread from now on
+	void BeginFrame();
+	// check the allocation count at the end of a frame and
+	// report the steady-state frames that allocated
+	void EndFrame();
+	// number of heap allocations by the render thread since
+	// BeginFrame()
+	unsigned long long GetFrameAllocations();
+}
@@ -0,0 +1,223 @@
+///////////////////////////////////////////////////////////////////////////////
+// camerapath.cpp
+// ============
+// record the camera path of a session and play it back for benchmarks
+///////////////////////////////////////////////////////////////////////////////
+
+#include "CameraPath.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// identifies camera path files, followed by the format version
+	const char PATH_FILE_MAGIC[4] = { 'C', 'P', 'T', 'H' };
+	const unsigned int PATH_FILE_VERSION = 1;
+	// record flag for the orthographic projection
+	const unsigned int FLAG_ORTHOGRAPHIC = 1;
+}
+
+/***********************************************************
+ *  CameraPath()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+CameraPath::CameraPath()
+{
+	m_replayIndex = 0;
+	m_bReplaying = false;
+}
+
+/***********************************************************
+ *  ~CameraPath()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+CameraPath::~CameraPath()
+{
+	StopRecording();
+}
+
+/***********************************************************
+ *  StartRecording()
+ *
+ *  This method is used for creating a camera path file and
+ *  writing its header.  The records are written as they
+ *  arrive, so a session that ends early keeps its path.
+ ***********************************************************/
+bool CameraPath::StartRecording(const char* filename)
+{
+	StopRecording();
+
+	m_file.open(filename, std::ios::binary | std::ios::trunc);
+	if (!m_file)
+	{
+		std::cout << "Could not create camera path file:" << filename << std::endl;
+		return(false);
+	}
+
+	m_file.write(PATH_FILE_MAGIC, sizeof(PATH_FILE_MAGIC));
+	m_file.write((const char*)&PATH_FILE_VERSION, sizeof(PATH_FILE_VERSION));
+
+	std::cout << "Recording camera path:" << filename << std::endl;
+	return(true);
+}
+
+/***********************************************************
+ *  StopRecording()
+ *
+ *  This method is used for closing the file being recorded.
+ ***********************************************************/
+void CameraPath::StopRecording()
+{
+	if (m_file.is_open())
+	{
+		m_file.close();
+	}
+}
+
+/***********************************************************
+ *  RecordState()
+ *
+ *  This method is used for writing one camera state and its
+ *  time to the file being recorded.
+ ***********************************************************/
+void CameraPath::RecordState(double time, const CAMERA_STATE& state)
+{
+	if (m_file.is_open() == false)
+	{
+		return;
+	}
+
+	PATH_RECORD record;
+	record.time = (float)time;
+	for (int i = 0; i < 3; i++)
+	{
+		record.position[i] = state.position[i];
+		record.front[i] = state.front[i];
+		record.up[i] = state.up[i];
+	}
+	record.zoom = state.zoom;
+	record.flags = state.bOrthographic ? FLAG_ORTHOGRAPHIC : 0;
+
+	m_file.write((const char*)&record, sizeof(record));
+}
+
+/***********************************************************
+ *  LoadReplay()
+ *
+ *  This method is used for reading all of the camera states
+ *  from a recorded camera path file.  The times are moved so
+ *  the first state is at zero, in case the file was recorded
+ *  with a delay before its first frame.
+ ***********************************************************/
+bool CameraPath::LoadReplay(const char* filename)
+{
+	StopReplay();
+
+	std::ifstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "Could not open camera path file:" << filename << std::endl;
+		return(false);
+	}
+
+	char magic[sizeof(PATH_FILE_MAGIC)] = {};
+	unsigned int version = 0;
+	file.read(magic, sizeof(magic));
+	file.read((char*)&version, sizeof(version));
+	if (!file || (memcmp(magic, PATH_FILE_MAGIC, sizeof(magic)) != 0) ||
+		(version != PATH_FILE_VERSION))
+	{
+		std::cout << "Not a supported camera path file:" << filename << std::endl;
+		return(false);
+	}
+
+	PATH_RECORD record;
+	while (file.read((char*)&record, sizeof(record)))
+	{
+		m_records.push_back(record);
+	}
+
+	if (m_records.empty())
+	{
+		std::cout << "Camera path file has no camera states:" << filename << std::endl;
+		return(false);
+	}
+
+	float startTime = m_records[0].time;
+	for (size_t i = 0; i < m_records.size(); i++)
+	{
+		m_records[i].time -= startTime;
+	}
+
+	m_replayIndex = 0;
+	m_bReplaying = true;
+
+	std::cout << "Replaying camera path:" << filename << ", states:" << m_records.size()
+		<< ", seconds:" << m_records.back().time << std::endl;
+	return(true);
+}
+
+/***********************************************************
+ *  GetReplayState()
+ *
+ *  This method is used for getting the camera state for the
+ *  passed in replay time, blending between the recorded
+ *  states before and after it.  The time must not go back
+ *  between calls.
+ ***********************************************************/
+bool CameraPath::GetReplayState(double time, CAMERA_STATE& state)
+{
+	if ((m_bReplaying == false) || (time > m_records.back().time))
+	{
+		return(false);
+	}
+
+	while ((m_replayIndex + 1 < m_records.size()) &&
+		(m_records[m_replayIndex + 1].time <= time))
+	{
+		m_replayIndex++;
+	}
+
+	const PATH_RECORD& before = m_records[m_replayIndex];
+	const PATH_RECORD& after = m_records[std::min(m_replayIndex + 1, m_records.size() - 1)];
+
+	float blend = 0.0f;
+	if (after.time > before.time)
+	{
+		blend = std::min(1.0f, std::max(0.0f, (float)((time - before.time) / (after.time - before.time))));
+	}
+
+	glm::vec3 beforePosition(before.position[0], before.position[1], before.position[2]);
+	glm::vec3 afterPosition(after.position[0], after.position[1], after.position[2]);
+	glm::vec3 beforeFront(before.front[0], before.front[1], before.front[2]);
+	glm::vec3 afterFront(after.front[0], after.front[1], after.front[2]);
+	glm::vec3 beforeUp(before.up[0], before.up[1], before.up[2]);
+	glm::vec3 afterUp(after.up[0], after.up[1], after.up[2]);
+
+	state.position = beforePosition + (afterPosition - beforePosition) * blend;
+	state.front = glm::normalize(beforeFront + (afterFront - beforeFront) * blend);
+	state.up = glm::normalize(beforeUp + (afterUp - beforeUp) * blend);
+	state.zoom = before.zoom + (after.zoom - before.zoom) * blend;
+	state.bOrthographic = ((before.flags & FLAG_ORTHOGRAPHIC) != 0);
+
+	return(true);
+}
+
+/***********************************************************
+ *  StopReplay()
+ *
+ *  This method is used for ending the replay and freeing the
+ *  loaded camera states.
+ ***********************************************************/
+void CameraPath::StopReplay()
+{
+	m_records.clear();
+	m_records.shrink_to_fit();
+	m_replayIndex = 0;
+	m_bReplaying = false;
+}
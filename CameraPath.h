@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+// camerapath.h
+// ============
+// record the camera path of a session and play it back for benchmarks
+//
+//  The camera state is written to a binary file every frame while
+//  recording, and replayed at a fixed timestep so every run of the
+//  same file renders the same frames.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <fstream>
+#include <vector>
+
+/***********************************************************
+ *  CameraPath
+ *
+ *  This class records timestamped camera states into a file
+ *  and reads them back for replay.  During replay the state
+ *  for any time is interpolated between the two recorded
+ *  states around it, so the replay timestep does not have to
+ *  match the frame times of the recorded session.
+ ***********************************************************/
+class CameraPath
+{
+public:
+	// the camera values that decide what is rendered
+	struct CAMERA_STATE
+	{
+		glm::vec3 position;
+		glm::vec3 front;
+		glm::vec3 up;
+		float zoom;
+		bool bOrthographic;
+	};
+
+	// constructor
+	CameraPath();
+	// destructor
+	~CameraPath();
+
+	// create the file and start writing camera states to it
+	bool StartRecording(const char* filename);
+	// close the file being recorded
+	void StopRecording();
+	bool IsRecording() const { return m_file.is_open(); }
+	// write the camera state for the passed in seconds since
+	// the start of the recording
+	void RecordState(double time, const CAMERA_STATE& state);
+
+	// read all of the camera states from a recorded file
+	bool LoadReplay(const char* filename);
+	bool IsReplaying() const { return m_bReplaying; }
+	// get the camera state for the passed in seconds since the
+	// start of the replay, returning false past the end
+	bool GetReplayState(double time, CAMERA_STATE& state);
+	// stop the replay and free the loaded states
+	void StopReplay();
+
+private:
+	// a camera state with its time, as stored in the file
+	struct PATH_RECORD
+	{
+		float time;
+		float position[3];
+		float front[3];
+		float up[3];
+		float zoom;
+		unsigned int flags;
+	};
+
+	// file being recorded
+	std::ofstream m_file;
+	// states loaded for replay
+	std::vector<PATH_RECORD> m_records;
+	// index of the last record at or before the replay time
+	size_t m_replayIndex;
+	bool m_bReplaying;
+};
@@ -0,0 +1,340 @@
+///////////////////////////////////////////////////////////////////////////////
+// framecapture.cpp
+// ============
+// capture rendered frames to image files without stalling the GPU
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameCapture.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// bytes per pixel read back from the framebuffer
+	const int READBACK_PIXEL_SIZE = 4;
+	// nanoseconds to wait for a readback when flushing at shutdown
+	const GLuint64 FLUSH_TIMEOUT = 1000000000;
+}
+
+/***********************************************************
+ *  FrameCapture()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameCapture::FrameCapture()
+{
+	for (int i = 0; i < READBACK_BUFFERS; i++)
+	{
+		m_readbacks[i].fence = 0;
+		m_readbacks[i].width = 0;
+		m_readbacks[i].height = 0;
+		m_readbacks[i].frameNumber = 0;
+	}
+	m_oldestReadback = 0;
+	m_pendingReadbacks = 0;
+
+	for (int i = 0; i < WRITE_BUFFERS; i++)
+	{
+		m_frames[i].width = 0;
+		m_frames[i].height = 0;
+		m_frames[i].frameNumber = 0;
+		m_freeFrames[i] = i;
+		m_queuedFrames[i] = 0;
+	}
+	m_freeCount = WRITE_BUFFERS;
+	m_queueHead = 0;
+	m_queueCount = 0;
+
+	m_bStopWriter = false;
+	m_bRecording = false;
+	m_bScreenshotRequested = false;
+	m_capturedFrames = 0;
+	m_droppedFrames = 0;
+}
+
+/***********************************************************
+ *  ~FrameCapture()
+ *
+ *  The destructor for the class.  Frames still being read
+ *  back or written are finished before it returns.
+ ***********************************************************/
+FrameCapture::~FrameCapture()
+{
+	CollectReadbacks(true);
+
+	if (m_writerThread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_bStopWriter = true;
+		}
+		m_frameQueued.notify_one();
+		m_writerThread.join();
+	}
+}
+
+/***********************************************************
+ *  CaptureScreenshot()
+ *
+ *  This method is used for requesting the capture of the
+ *  next rendered frame.
+ ***********************************************************/
+void FrameCapture::CaptureScreenshot()
+{
+	m_bScreenshotRequested = true;
+}
+
+/***********************************************************
+ *  StartRecording()
+ *
+ *  This method is used for starting the capture of every
+ *  rendered frame.
+ ***********************************************************/
+void FrameCapture::StartRecording()
+{
+	m_bRecording = true;
+	m_droppedFrames = 0;
+	std::cout << "Recording started at capture frame " << (m_capturedFrames + 1) << std::endl;
+}
+
+/***********************************************************
+ *  StopRecording()
+ *
+ *  This method is used for stopping the capture of frames.
+ *  Frames already read back are still written out.
+ ***********************************************************/
+void FrameCapture::StopRecording()
+{
+	m_bRecording = false;
+	std::cout << "Recording stopped after capture frame " << m_capturedFrames
+		<< ", " << m_droppedFrames << " frames dropped" << std::endl;
+}
+
+/***********************************************************
+ *  CaptureFrame()
+ *
+ *  This method is used for starting the readback of the
+ *  default framebuffer into the next pixel buffer object of
+ *  the ring.  glReadPixels() into a buffer object returns
+ *  without waiting, and a fence marks when the copy is done
+ *  so the buffer is only mapped a few frames later.
+ ***********************************************************/
+void FrameCapture::CaptureFrame(int width, int height)
+{
+	CollectReadbacks(false);
+
+	if ((m_bRecording == false) && (m_bScreenshotRequested == false))
+	{
+		return;
+	}
+	if ((width <= 0) || (height <= 0))
+	{
+		return;
+	}
+
+	// never wait for the GPU, a busy ring drops the frame
+	// while recording and delays a screenshot to the next one
+	if (m_pendingReadbacks == READBACK_BUFFERS)
+	{
+		if (m_bRecording)
+		{
+			m_droppedFrames++;
+		}
+		return;
+	}
+	m_bScreenshotRequested = false;
+
+	READBACK& readback = m_readbacks[(m_oldestReadback + m_pendingReadbacks) % READBACK_BUFFERS];
+	size_t bufferSize = (size_t)width * height * READBACK_PIXEL_SIZE;
+
+	if (readback.pixelBuffer.IsValid() == false)
+	{
+		readback.pixelBuffer = GpuResource::Create(GpuResource::BUFFER);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pixelBuffer.Get());
+	if (readback.pixelBuffer.GetMemorySize() != bufferSize)
+	{
+		glBufferData(GL_PIXEL_PACK_BUFFER, bufferSize, NULL, GL_STREAM_READ);
+		readback.pixelBuffer.SetMemorySize(bufferSize);
+	}
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+	glReadBuffer(GL_BACK);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	readback.width = width;
+	readback.height = height;
+	readback.frameNumber = ++m_capturedFrames;
+	m_pendingReadbacks++;
+}
+
+/***********************************************************
+ *  CollectReadbacks()
+ *
+ *  This method is used for copying the readbacks that the
+ *  GPU has finished into free frames, and queueing them for
+ *  the writer thread.  Unless waiting is requested, it stops
+ *  at the first readback that is not finished yet.
+ ***********************************************************/
+void FrameCapture::CollectReadbacks(bool bWait)
+{
+	while (m_pendingReadbacks > 0)
+	{
+		READBACK& readback = m_readbacks[m_oldestReadback];
+
+		GLenum waitResult = glClientWaitSync(
+			readback.fence,
+			bWait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+			bWait ? FLUSH_TIMEOUT : 0);
+		if ((waitResult == GL_TIMEOUT_EXPIRED) && (bWait == false))
+		{
+			break;
+		}
+
+		int frameIndex = -1;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_freeCount > 0)
+			{
+				frameIndex = m_freeFrames[--m_freeCount];
+			}
+		}
+
+		bool bCopied = false;
+		if ((frameIndex >= 0) && (waitResult != GL_WAIT_FAILED) && (waitResult != GL_TIMEOUT_EXPIRED))
+		{
+			CAPTURED_FRAME& frame = m_frames[frameIndex];
+			size_t bufferSize = readback.pixelBuffer.GetMemorySize();
+			if (frame.pixels.size() < bufferSize)
+			{
+				frame.pixels.resize(bufferSize);
+			}
+
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.pixelBuffer.Get());
+			void* pPixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bufferSize, GL_MAP_READ_BIT);
+			if (pPixels != NULL)
+			{
+				memcpy(frame.pixels.data(), pPixels, bufferSize);
+				glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+				frame.width = readback.width;
+				frame.height = readback.height;
+				frame.frameNumber = readback.frameNumber;
+				bCopied = true;
+			}
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		}
+
+		if (bCopied)
+		{
+			// the writer thread is started by the first capture
+			if (m_writerThread.joinable() == false)
+			{
+				m_writerThread = std::thread(&FrameCapture::WriterLoop, this);
+			}
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_queuedFrames[(m_queueHead + m_queueCount) % WRITE_BUFFERS] = frameIndex;
+				m_queueCount++;
+			}
+			m_frameQueued.notify_one();
+		}
+		else
+		{
+			if (frameIndex >= 0)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_freeFrames[m_freeCount++] = frameIndex;
+			}
+			m_droppedFrames++;
+		}
+
+		glDeleteSync(readback.fence);
+		readback.fence = 0;
+		m_oldestReadback = (m_oldestReadback + 1) % READBACK_BUFFERS;
+		m_pendingReadbacks--;
+	}
+}
+
+/***********************************************************
+ *  WriterLoop()
+ *
+ *  This method is run by the writer thread, writing each
+ *  queued frame to its file and returning it to the free
+ *  frames.  Queued frames are finished before it stops.
+ ***********************************************************/
+void FrameCapture::WriterLoop()
+{
+	while (true)
+	{
+		int frameIndex = -1;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_frameQueued.wait(lock, [this]() { return (m_queueCount > 0) || m_bStopWriter; });
+			if (m_queueCount == 0)
+			{
+				return;
+			}
+			frameIndex = m_queuedFrames[m_queueHead];
+			m_queueHead = (m_queueHead + 1) % WRITE_BUFFERS;
+			m_queueCount--;
+		}
+
+		WriteImageFile(m_frames[frameIndex]);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_freeFrames[m_freeCount++] = frameIndex;
+		}
+	}
+}
+
+/***********************************************************
+ *  WriteImageFile()
+ *
+ *  This method is used for writing a frame as a binary PPM
+ *  image.  OpenGL stores the bottom row first, so the rows
+ *  are written in reverse order and the alpha is dropped.
+ ***********************************************************/
+bool FrameCapture::WriteImageFile(const CAPTURED_FRAME& frame)
+{
+	char filename[32];
+	snprintf(filename, sizeof(filename), "capture_%06u.ppm", frame.frameNumber);
+
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)
+	{
+		std::cout << "Could not write frame capture file: " << filename << std::endl;
+		return(false);
+	}
+
+	char header[32];
+	int headerLength = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", frame.width, frame.height);
+	file.write(header, headerLength);
+
+	size_t rowSize = (size_t)frame.width * 3;
+	if (m_rowBuffer.size() < rowSize)
+	{
+		m_rowBuffer.resize(rowSize);
+	}
+
+	for (int row = frame.height - 1; row >= 0; row--)
+	{
+		const unsigned char* pSource = &frame.pixels[(size_t)row * frame.width * READBACK_PIXEL_SIZE];
+		for (int x = 0; x < frame.width; x++)
+		{
+			m_rowBuffer[x * 3 + 0] = pSource[x * READBACK_PIXEL_SIZE + 0];
+			m_rowBuffer[x * 3 + 1] = pSource[x * READBACK_PIXEL_SIZE + 1];
+			m_rowBuffer[x * 3 + 2] = pSource[x * READBACK_PIXEL_SIZE + 2];
+		}
+		file.write((const char*)m_rowBuffer.data(), rowSize);
+	}
+
+	return(file.good());
+}
@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+// framecapture.h
+// ============
+// capture rendered frames to image files without stalling the GPU
+//
+//  Frames are read back into a ring of pixel buffer objects, collected
+//  once their fences have signaled, and written out by a background
+//  thread.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GpuResource.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  FrameCapture
+ *
+ *  This class captures the default framebuffer as binary
+ *  PPM image files named capture_NNNNNN.ppm, either for a
+ *  single screenshot or for every frame while recording.
+ *  The readback of a frame is only mapped after the GPU has
+ *  finished it, and frames are dropped rather than waited
+ *  for when the readback or writer buffers are all busy.
+ ***********************************************************/
+class FrameCapture
+{
+public:
+	// constructor
+	FrameCapture();
+	// destructor
+	~FrameCapture();
+
+	// capture the next rendered frame only
+	void CaptureScreenshot();
+	// capture every rendered frame until stopped
+	void StartRecording();
+	void StopRecording();
+	bool IsRecording() const { return m_bRecording; }
+
+	// start the readback of the current frame when capturing,
+	// and collect the readbacks the GPU has finished, called
+	// once per frame before the buffers are swapped
+	void CaptureFrame(int width, int height);
+
+	// number of frames not captured because buffers were busy
+	unsigned int GetDroppedFrames() const { return m_droppedFrames; }
+
+private:
+	// number of frames that can be read back at the same time
+	static const int READBACK_BUFFERS = 3;
+	// number of frames that can wait to be written to files
+	static const int WRITE_BUFFERS = 8;
+
+	// a frame being copied into a pixel buffer object
+	struct READBACK
+	{
+		GpuResource pixelBuffer;
+		GLsync fence;
+		int width;
+		int height;
+		unsigned int frameNumber;
+	};
+
+	// a frame waiting to be written to an image file
+	struct CAPTURED_FRAME
+	{
+		std::vector<unsigned char> pixels;
+		int width;
+		int height;
+		unsigned int frameNumber;
+	};
+
+	// readbacks in flight, oldest first from m_oldestReadback
+	READBACK m_readbacks[READBACK_BUFFERS];
+	int m_oldestReadback;
+	int m_pendingReadbacks;
+
+	// frames owned by the writer thread, reused so capturing
+	// makes no heap allocations once the buffers are sized
+	CAPTURED_FRAME m_frames[WRITE_BUFFERS];
+	// indices of the frames free for new captures
+	int m_freeFrames[WRITE_BUFFERS];
+	int m_freeCount;
+	// indices of the frames queued for writing, in order
+	int m_queuedFrames[WRITE_BUFFERS];
+	int m_queueHead;
+	int m_queueCount;
+	// one RGB row of the image file, used by the writer thread
+	std::vector<unsigned char> m_rowBuffer;
+
+	std::thread m_writerThread;
+	std::mutex m_mutex;
+	std::condition_variable m_frameQueued;
+	bool m_bStopWriter;
+
+	bool m_bRecording;
+	bool m_bScreenshotRequested;
+	// number of frames captured, used to name the files
+	unsigned int m_capturedFrames;
+	unsigned int m_droppedFrames;
+
+	// copy the finished readbacks into frames for writing
+	void CollectReadbacks(bool bWait);
+	// write the queued frames until the writer is stopped
+	void WriterLoop();
+	// write one frame to its image file
+	bool WriteImageFile(const CAPTURED_FRAME& frame);
+};
@@ -0,0 +1,31 @@
+///////////////////////////////////////////////////////////////////////////////
+// framestats.h
+// ============
+// per-frame rendering counters shown on the performance HUD
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+/***********************************************************
+ *  FRAME_STATS
+ *
+ *  Counts of the rendering work submitted during one frame.
+ *  SceneManager resets these at the start of RenderScene()
+ *  and ViewManager displays them.
+ ***********************************************************/
+struct FRAME_STATS
+{
+	// number of GL draw calls issued for the scene meshes
+	unsigned int drawCalls;
+	// number of texture changes set into the shader
+	unsigned int textureChanges;
+	// number of uniform values uploaded to the shader
+	unsigned int uniformUploads;
+	// bytes of uniform data uploaded to the shader
+	size_t uniformBytes;
+	// number of uniform uploads skipped because the shader
+	// already held the same value
+	unsigned int uniformUploadsFiltered;
+};
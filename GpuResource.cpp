@@ -0,0 +1,263 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuresource.cpp
+// ============
+// own OpenGL objects and account for the GPU memory they use
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GpuResource.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// names of the resource types for the reports
+	const char* const g_TypeNames[GpuResource::TYPE_COUNT] = {
+		"textures",
+		"buffers",
+		"renderbuffers",
+		"framebuffers",
+		"vertex arrays",
+		"queries",
+		"programs" };
+
+	// registry of the live objects and their memory by type
+	unsigned int g_LiveCounts[GpuResource::TYPE_COUNT] = {};
+	size_t g_MemoryUsed[GpuResource::TYPE_COUNT] = {};
+}
+
+/***********************************************************
+ *  GpuResource()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+GpuResource::GpuResource()
+{
+	m_type = TEXTURE;
+	m_id = 0;
+	m_memorySize = 0;
+}
+
+/***********************************************************
+ *  ~GpuResource()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+GpuResource::~GpuResource()
+{
+	Reset();
+}
+
+/***********************************************************
+ *  GpuResource(GpuResource&&)
+ *
+ *  Take ownership of the object held by another handle.
+ ***********************************************************/
+GpuResource::GpuResource(GpuResource&& other) noexcept
+{
+	m_type = other.m_type;
+	m_id = other.m_id;
+	m_memorySize = other.m_memorySize;
+	other.m_id = 0;
+	other.m_memorySize = 0;
+}
+
+/***********************************************************
+ *  operator=(GpuResource&&)
+ *
+ *  Delete the owned object and take ownership of the object
+ *  held by another handle.
+ ***********************************************************/
+GpuResource& GpuResource::operator=(GpuResource&& other) noexcept
+{
+	if (this != &other)
+	{
+		Reset();
+		m_type = other.m_type;
+		m_id = other.m_id;
+		m_memorySize = other.m_memorySize;
+		other.m_id = 0;
+		other.m_memorySize = 0;
+	}
+	return(*this);
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  Create a new OpenGL object of the passed in type and
+ *  register it as live.
+ ***********************************************************/
+GpuResource GpuResource::Create(RESOURCE_TYPE type)
+{
+	GpuResource resource;
+	resource.m_type = type;
+
+	switch (type)
+	{
+	case TEXTURE:
+		glGenTextures(1, &resource.m_id);
+		break;
+	case BUFFER:
+		glGenBuffers(1, &resource.m_id);
+		break;
+	case RENDERBUFFER:
+		glGenRenderbuffers(1, &resource.m_id);
+		break;
+	case FRAMEBUFFER:
+		glGenFramebuffers(1, &resource.m_id);
+		break;
+	case VERTEX_ARRAY:
+		glGenVertexArrays(1, &resource.m_id);
+		break;
+	case QUERY:
+		glGenQueries(1, &resource.m_id);
+		break;
+	case PROGRAM:
+		resource.m_id = glCreateProgram();
+		break;
+	default:
+		break;
+	}
+
+	if (resource.m_id != 0)
+	{
+		g_LiveCounts[type]++;
+	}
+
+	return(resource);
+}
+
+/***********************************************************
+ *  SetMemorySize()
+ *
+ *  Record the bytes of GPU memory used by the object, such
+ *  as after allocating its storage.
+ ***********************************************************/
+void GpuResource::SetMemorySize(size_t bytes)
+{
+	if (m_id == 0)
+	{
+		return;
+	}
+
+	g_MemoryUsed[m_type] -= m_memorySize;
+	m_memorySize = bytes;
+	g_MemoryUsed[m_type] += m_memorySize;
+}
+
+/***********************************************************
+ *  Reset()
+ *
+ *  Delete the owned object and remove it from the registry.
+ ***********************************************************/
+void GpuResource::Reset()
+{
+	if (m_id == 0)
+	{
+		return;
+	}
+
+	switch (m_type)
+	{
+	case TEXTURE:
+		glDeleteTextures(1, &m_id);
+		break;
+	case BUFFER:
+		glDeleteBuffers(1, &m_id);
+		break;
+	case RENDERBUFFER:
+		glDeleteRenderbuffers(1, &m_id);
+		break;
+	case FRAMEBUFFER:
+		glDeleteFramebuffers(1, &m_id);
+		break;
+	case VERTEX_ARRAY:
+		glDeleteVertexArrays(1, &m_id);
+		break;
+	case QUERY:
+		glDeleteQueries(1, &m_id);
+		break;
+	case PROGRAM:
+		glDeleteProgram(m_id);
+		break;
+	default:
+		break;
+	}
+
+	g_LiveCounts[m_type]--;
+	g_MemoryUsed[m_type] -= m_memorySize;
+	m_id = 0;
+	m_memorySize = 0;
+}
+
+/***********************************************************
+ *  GetMemoryUsed()
+ ***********************************************************/
+size_t GpuResource::GetMemoryUsed(RESOURCE_TYPE type)
+{
+	return(g_MemoryUsed[type]);
+}
+
+/***********************************************************
+ *  GetTotalMemoryUsed()
+ ***********************************************************/
+size_t GpuResource::GetTotalMemoryUsed()
+{
+	size_t total = 0;
+	for (int i = 0; i < TYPE_COUNT; i++)
+	{
+		total += g_MemoryUsed[i];
+	}
+	return(total);
+}
+
+/***********************************************************
+ *  GetLiveCount()
+ ***********************************************************/
+unsigned int GpuResource::GetLiveCount(RESOURCE_TYPE type)
+{
+	return(g_LiveCounts[type]);
+}
+
+/***********************************************************
+ *  PrintMemoryReport()
+ *
+ *  Print the number of live objects and the GPU memory they
+ *  use for each resource type.
+ ***********************************************************/
+void GpuResource::PrintMemoryReport()
+{
+	std::cout << "GPU memory report:" << std::endl;
+	for (int i = 0; i < TYPE_COUNT; i++)
+	{
+		if (g_LiveCounts[i] > 0)
+		{
+			std::cout << "  " << g_TypeNames[i] << ": " << g_LiveCounts[i]
+				<< ", " << (g_MemoryUsed[i] / 1024) << " KB" << std::endl;
+		}
+	}
+	std::cout << "  total: " << (GetTotalMemoryUsed() / 1024) << " KB" << std::endl;
+}
+
+/***********************************************************
+ *  ReportLeaks()
+ *
+ *  Print the objects that are still alive.  Call this at
+ *  shutdown, after everything that owns GPU resources has
+ *  been destroyed.
+ ***********************************************************/
+bool GpuResource::ReportLeaks()
+{
+	bool bLeaks = false;
+	for (int i = 0; i < TYPE_COUNT; i++)
+	{
+		if (g_LiveCounts[i] > 0)
+		{
+			std::cerr << "ERROR: " << g_LiveCounts[i] << " " << g_TypeNames[i]
+				<< " still alive at shutdown, " << (g_MemoryUsed[i] / 1024) << " KB" << std::endl;
+			bLeaks = true;
+		}
+	}
+	return(bLeaks);
+}
@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuresource.h
+// ============
+// own OpenGL objects and account for the GPU memory they use
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+
+/***********************************************************
+ *  GpuResource
+ *
+ *  This class owns a single OpenGL object and deletes it
+ *  when the handle is destroyed or reset.  Handles can be
+ *  moved but not copied, so each object has exactly one
+ *  owner.  Every live handle is counted in a registry by
+ *  type, together with the memory size set for it, so the
+ *  GPU memory in use can be reported and objects that are
+ *  still alive at shutdown can be detected.
+ ***********************************************************/
+class GpuResource
+{
+public:
+	// the kinds of OpenGL objects that can be owned
+	enum RESOURCE_TYPE
+	{
+		TEXTURE = 0,
+		BUFFER,
+		RENDERBUFFER,
+		FRAMEBUFFER,
+		VERTEX_ARRAY,
+		QUERY,
+		PROGRAM,
+		TYPE_COUNT
+	};
+
+	// constructor for an empty handle
+	GpuResource();
+	// destructor
+	~GpuResource();
+
+	GpuResource(GpuResource&& other) noexcept;
+	GpuResource& operator=(GpuResource&& other) noexcept;
+	GpuResource(const GpuResource&) = delete;
+	GpuResource& operator=(const GpuResource&) = delete;
+
+	// create a new OpenGL object of the passed in type
+	static GpuResource Create(RESOURCE_TYPE type);
+
+	// the OpenGL name of the owned object, or 0 if empty
+	GLuint Get() const { return m_id; }
+	// whether the handle owns an object
+	bool IsValid() const { return m_id != 0; }
+
+	// set the bytes of GPU memory used by the object
+	void SetMemorySize(size_t bytes);
+	// bytes of GPU memory used by the object
+	size_t GetMemorySize() const { return m_memorySize; }
+
+	// delete the owned object and leave the handle empty
+	void Reset();
+
+	// bytes of GPU memory used by all live objects of a type
+	static size_t GetMemoryUsed(RESOURCE_TYPE type);
+	// bytes of GPU memory used by all live objects
+	static size_t GetTotalMemoryUsed();
+	// number of live objects of a type
+	static unsigned int GetLiveCount(RESOURCE_TYPE type);
+
+	// print the live objects and memory used for each type
+	static void PrintMemoryReport();
+	// print any objects still alive, returns true if there are any
+	static bool ReportLeaks();
+
+private:
+	// type of the owned object
+	RESOURCE_TYPE m_type;
+	// OpenGL name of the owned object
+	GLuint m_id;
+	// bytes of GPU memory used by the object
+	size_t m_memorySize;
+};
@@ -1,5 +1,7 @@
 #include <iostream>         // error handling and output
 #include <cstdlib>          // EXIT_FAILURE
+#include <chrono>           // startup timings
+#include <cstring>          // command line options
 
 #include <GL/glew.h>        // GLEW library
 #include "GLFW/glfw3.h"     // GLFW library
@@ -9,6 +11,8 @@
 #include <glm/gtx/transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "AllocationTracker.h"
+#include "GpuResource.h"
 #include "SceneManager.h"
 #include "ViewManager.h"
 #include "ShapeMeshes.h"
@@ -29,6 +33,16 @@ namespace
 	ShaderManager* g_ShaderManager = nullptr;
 	// view manager object for managing the 3D view setup and projection to 2D
 	ViewManager* g_ViewManager = nullptr;
+
+	// time the application was launched, for the startup timings
+	const std::chrono::steady_clock::time_point g_LaunchTime = std::chrono::steady_clock::now();
+
+	// milliseconds since the passed in time
+	double ElapsedMilliseconds(std::chrono::steady_clock::time_point start)
+	{
+		return(std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - start).count());
+	}
 }
 
 // Function declarations - all functions that are called manually
@@ -59,44 +73,106 @@ int main(int argc, char* argv[])
     // try to create the main display window
     g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
 
+    // --record <file> saves the camera path of this session, and
+    // --replay <file> plays one back as a repeatable benchmark
+    // --texture-budget <MB> limits the memory used by textures
+    long textureBudgetMB = 0;
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (strcmp(argv[i], "--record") == 0)
+        {
+            g_ViewManager->StartCameraRecording(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--replay") == 0)
+        {
+            g_ViewManager->StartCameraReplay(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--texture-budget") == 0)
+        {
+            textureBudgetMB = atol(argv[++i]);
+        }
+    }
+
     // if GLEW fails initialization, then terminate the application
     if (InitializeGLEW() == false)
     {
         return(EXIT_FAILURE);
     }
 
+    double windowMilliseconds = ElapsedMilliseconds(g_LaunchTime);
+
     // load the shader code from the external GLSL files
+    std::chrono::steady_clock::time_point phaseStart = std::chrono::steady_clock::now();
     g_ShaderManager->LoadShaders(
         "../../../Utilities/shaders/vertexShader.glsl",
         "../../../Utilities/shaders/fragmentShader.glsl");
     g_ShaderManager->use();
+    double shaderMilliseconds = ElapsedMilliseconds(phaseStart);
 
     // try to create a new scene manager object and prepare the 3D scene
     g_SceneManager = new SceneManager(g_ShaderManager);
+    if (textureBudgetMB > 0)
+    {
+        g_SceneManager->SetTextureMemoryBudget((size_t)textureBudgetMB * 1024 * 1024);
+    }
+    phaseStart = std::chrono::steady_clock::now();
     g_SceneManager->PrepareScene();
 
     //  FIX: Bind textures to GPU slots after loading
     g_SceneManager->BindGLTextures();
 
+    // show the GPU memory used by the loaded scene
+    GpuResource::PrintMemoryReport();
+
+    // Enable z-depth, once since only the HUD turns it off and
+    // it turns it back on after drawing
+    glEnable(GL_DEPTH_TEST);
+    double sceneMilliseconds = ElapsedMilliseconds(phaseStart);
+    bool bFirstFrame = true;
+
     // loop will keep running until the application is closed 
     while (!glfwWindowShouldClose(g_Window))
     {
-        // Enable z-depth
-        glEnable(GL_DEPTH_TEST);
+        // fit the textures to the texture memory budget before
+        // the frame is timed, since this may upload a texture
+        g_SceneManager->UpdateTextureResidency();
+
+        // start counting the heap allocations made by this frame
+        AllocationTracker::BeginFrame();
+
+        // convert from 3D object space to 2D view and bind the
+        // render target for this frame
+        g_ViewManager->PrepareSceneView();
 
         // Clear the frame and z buffers
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        // convert from 3D object space to 2D view
-        g_ViewManager->PrepareSceneView();
-
         // refresh the 3D scene
         g_SceneManager->RenderScene();
 
+        // upscale the rendered scene into the window
+        g_ViewManager->PresentSceneView();
+
+        // show this frame's counters when the HUD is on
+        g_ViewManager->UpdatePerformanceHUD(g_SceneManager->GetFrameStats());
+
+        // report if a steady-state frame allocated any heap memory
+        AllocationTracker::EndFrame();
+
         // Flips the the back buffer with the front buffer every frame.
         glfwSwapBuffers(g_Window);
 
+        // report how long the application took to show the scene
+        if (bFirstFrame)
+        {
+            std::cout << "Time to first frame " << ElapsedMilliseconds(g_LaunchTime) << " ms:"
+                << " window " << windowMilliseconds << " ms,"
+                << " shaders " << shaderMilliseconds << " ms,"
+                << " scene " << sceneMilliseconds << " ms" << std::endl;
+            bFirstFrame = false;
+        }
+
         // query the latest GLFW events
         glfwPollEvents();
     }
@@ -118,6 +194,9 @@ int main(int argc, char* argv[])
         g_ShaderManager = NULL;
     }
 
+    // every GPU resource should have been released by now
+    GpuResource::ReportLeaks();
+
     // Terminates the program successfully
     exit(EXIT_SUCCESS);
 }
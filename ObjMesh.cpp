@@ -0,0 +1,791 @@
+///////////////////////////////////////////////////////////////////////////////
+// objmesh.cpp
+// ============
+// load triangle meshes from Wavefront OBJ files into OpenGL buffers
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ObjMesh.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// declaration of global variables
+namespace
+{
+	// number of floats for each interleaved vertex attribute
+	const int g_FloatsPerPosition = 3;
+	const int g_FloatsPerNormal = 3;
+	const int g_FloatsPerUV = 2;
+	const int g_FloatsPerVertex = g_FloatsPerPosition + g_FloatsPerNormal + g_FloatsPerUV;
+
+	// smallest amount of file data worth handing to a worker thread
+	const size_t g_MinChunkBytes = 256 * 1024;
+
+	// marks a face corner without a texture coordinate or normal
+	const int g_NoIndex = INT_MIN;
+
+	// element types referenced by a face corner
+	enum { POSITION = 0, UV = 1, NORMAL = 2 };
+
+	// read-only view of a memory mapped file
+	struct MAPPED_FILE
+	{
+		const char* data = nullptr;
+		size_t size = 0;
+#ifdef _WIN32
+		HANDLE hFile = INVALID_HANDLE_VALUE;
+		HANDLE hMapping = NULL;
+#else
+		int fd = -1;
+#endif
+	};
+
+	// one corner of a triangle as referenced in the file
+	struct OBJ_CORNER
+	{
+		int index[3];
+		// bit set for each index that is relative to the chunk start
+		unsigned char relative;
+	};
+
+	// the elements parsed from one chunk of the file
+	struct OBJ_CHUNK
+	{
+		const char* begin = nullptr;
+		const char* end = nullptr;
+		std::vector<glm::vec3> positions;
+		std::vector<glm::vec2> uvs;
+		std::vector<glm::vec3> normals;
+		// triangulated faces, three corners per triangle
+		std::vector<OBJ_CORNER> corners;
+		// number of each element type in all preceding chunks
+		int prefix[3] = { 0, 0, 0 };
+	};
+
+	// resolved corner used as the de-duplication key
+	struct VERTEX_KEY
+	{
+		int position;
+		int uv;
+		int normal;
+
+		bool operator==(const VERTEX_KEY& other) const
+		{
+			return (position == other.position) && (uv == other.uv) && (normal == other.normal);
+		}
+	};
+
+	struct VERTEX_KEY_HASH
+	{
+		size_t operator()(const VERTEX_KEY& key) const
+		{
+			size_t hash = (size_t)(unsigned int)key.position * 73856093u;
+			hash ^= (size_t)(unsigned int)key.uv * 19349663u;
+			hash ^= (size_t)(unsigned int)key.normal * 83492791u;
+			return(hash);
+		}
+	};
+
+	/***********************************************************
+	 *  MapFile()
+	 *
+	 *  Map the whole file into memory as read-only data.
+	 ***********************************************************/
+	bool MapFile(const char* filename, MAPPED_FILE& file)
+	{
+#ifdef _WIN32
+		file.hFile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+			OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (file.hFile == INVALID_HANDLE_VALUE)
+		{
+			return(false);
+		}
+
+		LARGE_INTEGER fileSize;
+		if ((GetFileSizeEx(file.hFile, &fileSize) == FALSE) || (fileSize.QuadPart == 0))
+		{
+			CloseHandle(file.hFile);
+			file.hFile = INVALID_HANDLE_VALUE;
+			return(false);
+		}
+		file.size = (size_t)fileSize.QuadPart;
+
+		file.hMapping = CreateFileMappingA(file.hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (file.hMapping != NULL)
+		{
+			file.data = (const char*)MapViewOfFile(file.hMapping, FILE_MAP_READ, 0, 0, 0);
+		}
+#else
+		file.fd = open(filename, O_RDONLY);
+		if (file.fd < 0)
+		{
+			return(false);
+		}
+
+		struct stat fileStat;
+		if ((fstat(file.fd, &fileStat) != 0) || (fileStat.st_size == 0))
+		{
+			close(file.fd);
+			file.fd = -1;
+			return(false);
+		}
+		file.size = (size_t)fileStat.st_size;
+
+		void* data = mmap(NULL, file.size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+		if (data != MAP_FAILED)
+		{
+			file.data = (const char*)data;
+		}
+#endif
+		return(file.data != nullptr);
+	}
+
+	/***********************************************************
+	 *  UnmapFile()
+	 *
+	 *  Release the memory mapping and the file handles.
+	 ***********************************************************/
+	void UnmapFile(MAPPED_FILE& file)
+	{
+#ifdef _WIN32
+		if (file.data != nullptr)
+			UnmapViewOfFile(file.data);
+		if (file.hMapping != NULL)
+			CloseHandle(file.hMapping);
+		if (file.hFile != INVALID_HANDLE_VALUE)
+			CloseHandle(file.hFile);
+		file.hMapping = NULL;
+		file.hFile = INVALID_HANDLE_VALUE;
+#else
+		if (file.data != nullptr)
+			munmap((void*)file.data, file.size);
+		if (file.fd >= 0)
+			close(file.fd);
+		file.fd = -1;
+#endif
+		file.data = nullptr;
+		file.size = 0;
+	}
+
+	inline void SkipSpaces(const char*& p, const char* end)
+	{
+		while ((p < end) && ((*p == ' ') || (*p == '\t') || (*p == '\r')))
+			p++;
+	}
+
+	inline bool IsDigit(char c)
+	{
+		return((c >= '0') && (c <= '9'));
+	}
+
+	/***********************************************************
+	 *  ParseInt()
+	 *
+	 *  Parse a signed integer without reading past the end
+	 *  of the mapped data.  Returns 0 when no digits are found.
+	 ***********************************************************/
+	int ParseInt(const char*& p, const char* end)
+	{
+		bool bNegative = false;
+		if ((p < end) && ((*p == '-') || (*p == '+')))
+		{
+			bNegative = (*p == '-');
+			p++;
+		}
+
+		int value = 0;
+		while ((p < end) && IsDigit(*p))
+		{
+			value = (value * 10) + (*p - '0');
+			p++;
+		}
+
+		return(bNegative ? -value : value);
+	}
+
+	/***********************************************************
+	 *  ParseFloat()
+	 *
+	 *  Parse a decimal floating point value, with an optional
+	 *  exponent, without reading past the end of the mapped data.
+	 ***********************************************************/
+	float ParseFloat(const char*& p, const char* end)
+	{
+		SkipSpaces(p, end);
+
+		bool bNegative = false;
+		if ((p < end) && ((*p == '-') || (*p == '+')))
+		{
+			bNegative = (*p == '-');
+			p++;
+		}
+
+		double value = 0.0;
+		while ((p < end) && IsDigit(*p))
+		{
+			value = (value * 10.0) + (*p - '0');
+			p++;
+		}
+
+		if ((p < end) && (*p == '.'))
+		{
+			p++;
+			double scale = 0.1;
+			while ((p < end) && IsDigit(*p))
+			{
+				value += (*p - '0') * scale;
+				scale *= 0.1;
+				p++;
+			}
+		}
+
+		if ((p < end) && ((*p == 'e') || (*p == 'E')))
+		{
+			p++;
+			value *= std::pow(10.0, (double)ParseInt(p, end));
+		}
+
+		return((float)(bNegative ? -value : value));
+	}
+
+	/***********************************************************
+	 *  ParseCorner()
+	 *
+	 *  Parse one "v", "v/vt", "v//vn" or "v/vt/vn" face corner.
+	 *  Negative (relative) indices are converted to offsets
+	 *  from the start of the chunk and flagged for later.
+	 ***********************************************************/
+	bool ParseCorner(const char*& p, const char* end, const OBJ_CHUNK& chunk, OBJ_CORNER& corner)
+	{
+		SkipSpaces(p, end);
+		if ((p >= end) || ((IsDigit(*p) == false) && (*p != '-')))
+		{
+			return(false);
+		}
+
+		int raw[3] = { ParseInt(p, end), 0, 0 };
+		if ((p < end) && (*p == '/'))
+		{
+			p++;
+			raw[UV] = ParseInt(p, end);
+			if ((p < end) && (*p == '/'))
+			{
+				p++;
+				raw[NORMAL] = ParseInt(p, end);
+			}
+		}
+
+		const int counts[3] = {
+			(int)chunk.positions.size(),
+			(int)chunk.uvs.size(),
+			(int)chunk.normals.size() };
+
+		corner.relative = 0;
+		for (int i = 0; i < 3; i++)
+		{
+			if (raw[i] > 0)
+			{
+				corner.index[i] = raw[i] - 1;
+			}
+			else if (raw[i] < 0)
+			{
+				corner.index[i] = counts[i] + raw[i];
+				corner.relative |= (1 << i);
+			}
+			else
+			{
+				corner.index[i] = g_NoIndex;
+			}
+		}
+
+		// skip anything unexpected up to the next corner
+		while ((p < end) && (*p != ' ') && (*p != '\t') && (*p != '\r'))
+			p++;
+
+		return(corner.index[POSITION] != g_NoIndex);
+	}
+
+	/***********************************************************
+	 *  ParseChunk()
+	 *
+	 *  Parse the vertex, texture coordinate, normal and face
+	 *  lines in one chunk.  Polygons are fan triangulated.
+	 ***********************************************************/
+	void ParseChunk(OBJ_CHUNK& chunk)
+	{
+		const char* p = chunk.begin;
+		const char* end = chunk.end;
+		OBJ_CORNER polygon[3];
+
+		while (p < end)
+		{
+			const char* lineEnd = (const char*)memchr(p, '\n', end - p);
+			if (lineEnd == nullptr)
+				lineEnd = end;
+
+			SkipSpaces(p, lineEnd);
+			if ((lineEnd - p) > 2)
+			{
+				if ((p[0] == 'v') && ((p[1] == ' ') || (p[1] == '\t')))
+				{
+					p += 2;
+					glm::vec3 position;
+					position.x = ParseFloat(p, lineEnd);
+					position.y = ParseFloat(p, lineEnd);
+					position.z = ParseFloat(p, lineEnd);
+					chunk.positions.push_back(position);
+				}
+				else if ((p[0] == 'v') && (p[1] == 't'))
+				{
+					p += 2;
+					glm::vec2 uv;
+					uv.x = ParseFloat(p, lineEnd);
+					uv.y = ParseFloat(p, lineEnd);
+					chunk.uvs.push_back(uv);
+				}
+				else if ((p[0] == 'v') && (p[1] == 'n'))
+				{
+					p += 2;
+					glm::vec3 normal;
+					normal.x = ParseFloat(p, lineEnd);
+					normal.y = ParseFloat(p, lineEnd);
+					normal.z = ParseFloat(p, lineEnd);
+					chunk.normals.push_back(normal);
+				}
+				else if ((p[0] == 'f') && ((p[1] == ' ') || (p[1] == '\t')))
+				{
+					p += 2;
+					int nCorners = 0;
+					OBJ_CORNER corner;
+					while (ParseCorner(p, lineEnd, chunk, corner))
+					{
+						if (nCorners < 2)
+						{
+							polygon[nCorners] = corner;
+						}
+						else
+						{
+							// fan triangulation around the first corner
+							polygon[2] = corner;
+							chunk.corners.push_back(polygon[0]);
+							chunk.corners.push_back(polygon[1]);
+							chunk.corners.push_back(polygon[2]);
+							polygon[1] = corner;
+						}
+						nCorners++;
+					}
+				}
+			}
+
+			p = (lineEnd < end) ? lineEnd + 1 : end;
+		}
+	}
+
+	/***********************************************************
+	 *  ResolveIndex()
+	 *
+	 *  Convert a corner index into an index within the whole
+	 *  file, returning g_NoIndex when it is missing or invalid.
+	 ***********************************************************/
+	inline int ResolveIndex(const OBJ_CORNER& corner, const OBJ_CHUNK& chunk, int element, int total)
+	{
+		int index = corner.index[element];
+		if (index == g_NoIndex)
+			return(g_NoIndex);
+
+		if (corner.relative & (1 << element))
+			index += chunk.prefix[element];
+
+		return(((index >= 0) && (index < total)) ? index : g_NoIndex);
+	}
+
+	/***********************************************************
+	 *  FindChunk()
+	 *
+	 *  Find the chunk holding an element by its index within
+	 *  the whole file, so the parsed chunk arrays can be read
+	 *  in place without gathering them into one array.
+	 ***********************************************************/
+	inline const OBJ_CHUNK& FindChunk(const std::vector<OBJ_CHUNK>& chunks, int element, int index)
+	{
+		// the last chunk whose elements start at or before the index
+		auto next = std::upper_bound(chunks.begin(), chunks.end(), index,
+			[element](int value, const OBJ_CHUNK& chunk) { return value < chunk.prefix[element]; });
+		return(*(next - 1));
+	}
+
+	inline const glm::vec3& PositionAt(const std::vector<OBJ_CHUNK>& chunks, int index)
+	{
+		const OBJ_CHUNK& chunk = FindChunk(chunks, POSITION, index);
+		return(chunk.positions[index - chunk.prefix[POSITION]]);
+	}
+
+	inline const glm::vec2& UVAt(const std::vector<OBJ_CHUNK>& chunks, int index)
+	{
+		const OBJ_CHUNK& chunk = FindChunk(chunks, UV, index);
+		return(chunk.uvs[index - chunk.prefix[UV]]);
+	}
+
+	inline const glm::vec3& NormalAt(const std::vector<OBJ_CHUNK>& chunks, int index)
+	{
+		const OBJ_CHUNK& chunk = FindChunk(chunks, NORMAL, index);
+		return(chunk.normals[index - chunk.prefix[NORMAL]]);
+	}
+
+	/***********************************************************
+	 *  ParseFile()
+	 *
+	 *  Map an OBJ file, split it on line boundaries into chunks
+	 *  and parse the chunks in parallel.  Counts the elements
+	 *  before each chunk and in the whole file, and the face
+	 *  corners.  This only uses the CPU.
+	 ***********************************************************/
+	bool ParseFile(const char* filename, std::vector<OBJ_CHUNK>& chunks, int totals[3], size_t& nCorners)
+	{
+		MAPPED_FILE file;
+		if (MapFile(filename, file) == false)
+		{
+			std::cout << "Could not load mesh:" << filename << std::endl;
+			UnmapFile(file);
+			return false;
+		}
+
+		// split the file into chunks on line boundaries
+		size_t nThreads = std::max(1u, std::thread::hardware_concurrency());
+		size_t nChunks = std::min(nThreads, (file.size / g_MinChunkBytes) + 1);
+		chunks.assign(nChunks, OBJ_CHUNK());
+
+		const char* fileEnd = file.data + file.size;
+		const char* chunkBegin = file.data;
+		for (size_t i = 0; i < nChunks; i++)
+		{
+			const char* chunkEnd = fileEnd;
+			if (i + 1 < nChunks)
+			{
+				chunkEnd = std::max(chunkBegin, file.data + (file.size * (i + 1)) / nChunks);
+				const char* newline = (const char*)memchr(chunkEnd, '\n', fileEnd - chunkEnd);
+				chunkEnd = (newline != nullptr) ? newline + 1 : fileEnd;
+			}
+			chunks[i].begin = chunkBegin;
+			chunks[i].end = chunkEnd;
+			chunkBegin = chunkEnd;
+		}
+
+		// parse the chunks in parallel, using this thread for the first one
+		std::vector<std::thread> workers;
+		for (size_t i = 1; i < nChunks; i++)
+		{
+			workers.emplace_back(ParseChunk, std::ref(chunks[i]));
+		}
+		ParseChunk(chunks[0]);
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+
+		UnmapFile(file);
+
+		// count the elements before each chunk, so file indices can
+		// be found in the chunk arrays
+		totals[POSITION] = 0;
+		totals[UV] = 0;
+		totals[NORMAL] = 0;
+		nCorners = 0;
+		for (OBJ_CHUNK& chunk : chunks)
+		{
+			chunk.prefix[POSITION] = totals[POSITION];
+			chunk.prefix[UV] = totals[UV];
+			chunk.prefix[NORMAL] = totals[NORMAL];
+			totals[POSITION] += (int)chunk.positions.size();
+			totals[UV] += (int)chunk.uvs.size();
+			totals[NORMAL] += (int)chunk.normals.size();
+			nCorners += chunk.corners.size();
+		}
+
+		return true;
+	}
+}
+
+/***********************************************************
+ *  ObjMesh()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ObjMesh::ObjMesh()
+{
+	m_nVertices = 0;
+	m_nIndices = 0;
+}
+
+/***********************************************************
+ *  ~ObjMesh()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ObjMesh::~ObjMesh()
+{
+	DestroyMesh();
+}
+
+/***********************************************************
+ *  LoadMesh()
+ *
+ *  This method is used for loading a mesh from an OBJ file.
+ *  The file is memory mapped and split on line boundaries
+ *  into chunks that are parsed in parallel.  The face corners
+ *  are then de-duplicated with a hash map while the indices
+ *  and vertices are written directly into mapped OpenGL
+ *  buffers.  The elements are read from the chunk arrays in
+ *  place, so the mesh is never copied into whole file arrays.
+ ***********************************************************/
+bool ObjMesh::LoadMesh(const char* filename)
+{
+	auto startTime = std::chrono::steady_clock::now();
+
+	DestroyMesh();
+
+	std::vector<OBJ_CHUNK> chunks;
+	int totals[3] = { 0, 0, 0 };
+	size_t nCorners = 0;
+	if (ParseFile(filename, chunks, totals, nCorners) == false)
+	{
+		return false;
+	}
+
+	if ((nCorners == 0) || (totals[POSITION] == 0))
+	{
+		std::cout << "Mesh file has no faces:" << filename << std::endl;
+		return false;
+	}
+
+	m_vao = GpuResource::Create(GpuResource::VERTEX_ARRAY);
+	glBindVertexArray(m_vao.Get());
+
+	// write the de-duplicated indices straight into the element buffer
+	m_ibo = GpuResource::Create(GpuResource::BUFFER);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ibo.Get());
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, nCorners * sizeof(GLuint), NULL, GL_STATIC_DRAW);
+	m_ibo.SetMemorySize(nCorners * sizeof(GLuint));
+	GLuint* indices = (GLuint*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0,
+		nCorners * sizeof(GLuint), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+	if (indices == nullptr)
+	{
+		std::cout << "Could not map index buffer for mesh:" << filename << std::endl;
+		glBindVertexArray(0);
+		DestroyMesh();
+		return false;
+	}
+
+	// the lookup also holds the unique vertices for the vertex
+	// buffer, keyed by their file indices
+	std::unordered_map<VERTEX_KEY, GLuint, VERTEX_KEY_HASH> vertexLookup;
+	vertexLookup.reserve(nCorners / 2);
+
+	bool bMissingNormals = false;
+	bool bValid = true;
+	size_t nIndex = 0;
+	for (size_t c = 0; (c < chunks.size()) && bValid; c++)
+	{
+		const OBJ_CHUNK& chunk = chunks[c];
+		for (size_t i = 0; (i < chunk.corners.size()) && bValid; i++)
+		{
+			VERTEX_KEY key;
+			key.position = ResolveIndex(chunk.corners[i], chunk, POSITION, totals[POSITION]);
+			key.uv = ResolveIndex(chunk.corners[i], chunk, UV, totals[UV]);
+			key.normal = ResolveIndex(chunk.corners[i], chunk, NORMAL, totals[NORMAL]);
+			if (key.position == g_NoIndex)
+			{
+				bValid = false;
+				break;
+			}
+			if (key.normal == g_NoIndex)
+			{
+				bMissingNormals = true;
+			}
+
+			auto result = vertexLookup.emplace(key, (GLuint)vertexLookup.size());
+			indices[nIndex++] = result.first->second;
+		}
+	}
+
+	glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
+
+	if (bValid == false)
+	{
+		std::cout << "Mesh file has invalid face indices:" << filename << std::endl;
+		glBindVertexArray(0);
+		DestroyMesh();
+		return false;
+	}
+
+	// smooth normals for faces that do not reference one
+	std::vector<glm::vec3> smoothNormals;
+	if (bMissingNormals)
+	{
+		smoothNormals.assign(totals[POSITION], glm::vec3(0.0f));
+		for (const OBJ_CHUNK& chunk : chunks)
+		{
+			for (size_t i = 0; i + 2 < chunk.corners.size(); i += 3)
+			{
+				int a = ResolveIndex(chunk.corners[i], chunk, POSITION, totals[POSITION]);
+				int b = ResolveIndex(chunk.corners[i + 1], chunk, POSITION, totals[POSITION]);
+				int c = ResolveIndex(chunk.corners[i + 2], chunk, POSITION, totals[POSITION]);
+				// area weighted face normal
+				const glm::vec3& positionA = PositionAt(chunks, a);
+				glm::vec3 faceNormal = glm::cross(PositionAt(chunks, b) - positionA, PositionAt(chunks, c) - positionA);
+				smoothNormals[a] = smoothNormals[a] + faceNormal;
+				smoothNormals[b] = smoothNormals[b] + faceNormal;
+				smoothNormals[c] = smoothNormals[c] + faceNormal;
+			}
+		}
+	}
+
+	// write the unique vertices straight into the vertex buffer
+	const size_t nVertices = vertexLookup.size();
+	const size_t stride = g_FloatsPerVertex * sizeof(float);
+	m_vbo = GpuResource::Create(GpuResource::BUFFER);
+	glBindBuffer(GL_ARRAY_BUFFER, m_vbo.Get());
+	glBufferData(GL_ARRAY_BUFFER, nVertices * stride, NULL, GL_STATIC_DRAW);
+	m_vbo.SetMemorySize(nVertices * stride);
+	float* vertices = (float*)glMapBufferRange(GL_ARRAY_BUFFER, 0,
+		nVertices * stride, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+	if (vertices != nullptr)
+	{
+		for (const auto& entry : vertexLookup)
+		{
+			const VERTEX_KEY& key = entry.first;
+			glm::vec3 normal(0.0f, 1.0f, 0.0f);
+			if (key.normal != g_NoIndex)
+			{
+				normal = NormalAt(chunks, key.normal);
+			}
+			else if (glm::length(smoothNormals[key.position]) > 0.0f)
+			{
+				normal = glm::normalize(smoothNormals[key.position]);
+			}
+			glm::vec2 uv(0.0f, 0.0f);
+			if (key.uv != g_NoIndex)
+			{
+				uv = UVAt(chunks, key.uv);
+			}
+
+			const glm::vec3& position = PositionAt(chunks, key.position);
+			float* vertex = vertices + (size_t)entry.second * g_FloatsPerVertex;
+			vertex[0] = position.x;
+			vertex[1] = position.y;
+			vertex[2] = position.z;
+			vertex[3] = normal.x;
+			vertex[4] = normal.y;
+			vertex[5] = normal.z;
+			vertex[6] = uv.x;
+			vertex[7] = uv.y;
+		}
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+	}
+
+	// same attribute layout as the ShapeMeshes class
+	glVertexAttribPointer(0, g_FloatsPerPosition, GL_FLOAT, GL_FALSE, (GLsizei)stride, (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, g_FloatsPerNormal, GL_FLOAT, GL_FALSE, (GLsizei)stride,
+		(void*)(sizeof(float) * g_FloatsPerPosition));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(2, g_FloatsPerUV, GL_FLOAT, GL_FALSE, (GLsizei)stride,
+		(void*)(sizeof(float) * (g_FloatsPerPosition + g_FloatsPerNormal)));
+	glEnableVertexAttribArray(2);
+
+	glBindVertexArray(0);
+
+	if (vertices == nullptr)
+	{
+		std::cout << "Could not map vertex buffer for mesh:" << filename << std::endl;
+		DestroyMesh();
+		return false;
+	}
+
+	m_nVertices = (GLuint)nVertices;
+	m_nIndices = (GLuint)nCorners;
+
+	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - startTime);
+	std::cout << "Successfully loaded mesh:" << filename << ", vertices:" << m_nVertices
+		<< ", triangles:" << (m_nIndices / 3) << ", threads:" << chunks.size()
+		<< ", time:" << elapsed.count() << "ms" << std::endl;
+
+	return true;
+}
+
+/***********************************************************
+ *  ParseMeshFile()
+ *
+ *  This method is used for parsing an OBJ file the same way
+ *  LoadMesh() does, without creating any OpenGL buffers, so
+ *  the parser can be timed without an OpenGL context.
+ *  Returns the number of triangle corners in the file, or
+ *  zero if it could not be read.
+ ***********************************************************/
+size_t ObjMesh::ParseMeshFile(const char* filename)
+{
+	std::vector<OBJ_CHUNK> chunks;
+	int totals[3] = { 0, 0, 0 };
+	size_t nCorners = 0;
+	if (ParseFile(filename, chunks, totals, nCorners) == false)
+	{
+		return(0);
+	}
+
+	return(nCorners);
+}
+
+/***********************************************************
+ *  DestroyMesh()
+ *
+ *  This method is used for freeing the OpenGL buffers that
+ *  hold the loaded mesh.
+ ***********************************************************/
+void ObjMesh::DestroyMesh()
+{
+	m_ibo.Reset();
+	m_vbo.Reset();
+	m_vao.Reset();
+
+	m_nVertices = 0;
+	m_nIndices = 0;
+}
+
+/***********************************************************
+ *  DrawMesh()
+ *
+ *  This method is used for drawing the loaded mesh with
+ *  the transformations and shader values already set.
+ ***********************************************************/
+void ObjMesh::DrawMesh()
+{
+	if (m_nIndices == 0)
+		return;
+
+	glBindVertexArray(m_vao.Get());
+	glDrawElements(GL_TRIANGLES, m_nIndices, GL_UNSIGNED_INT, (void*)0);
+	glBindVertexArray(0);
+}
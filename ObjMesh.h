@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////////////////////////
+// objmesh.h
+// ============
+// load triangle meshes from Wavefront OBJ files into OpenGL buffers
+//
+//  The file is memory mapped and parsed in parallel chunks, and the
+//  de-duplicated vertices are written straight into a mapped GPU buffer.
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "GpuResource.h"
+
+/***********************************************************
+ *  ObjMesh
+ *
+ *  This class loads a mesh from an OBJ file and draws it
+ *  with the same vertex layout as the ShapeMeshes class
+ *  (position, normal, texture coordinate), so the shaders
+ *  and SceneManager methods work unchanged.
+ ***********************************************************/
+class ObjMesh
+{
+public:
+	// constructor
+	ObjMesh();
+	// destructor
+	~ObjMesh();
+
+	// load the mesh data from the passed in OBJ file
+	bool LoadMesh(const char* filename);
+	// free the OpenGL buffers for the loaded mesh
+	void DestroyMesh();
+	// draw the loaded mesh
+	void DrawMesh();
+
+	// parse an OBJ file without loading it, returning the
+	// number of triangle corners
+	static size_t ParseMeshFile(const char* filename);
+
+	// number of unique vertices after de-duplication
+	unsigned int GetVertexCount() const { return m_nVertices; }
+	// number of indices in the element buffer
+	unsigned int GetIndexCount() const { return m_nIndices; }
+
+private:
+	// vertex array object for the mesh
+	GpuResource m_vao;
+	// vertex buffer object holding the interleaved vertices
+	GpuResource m_vbo;
+	// element buffer object holding the triangle indices
+	GpuResource m_ibo;
+	// number of unique vertices in the vertex buffer
+	GLuint m_nVertices;
+	// number of indices in the element buffer
+	GLuint m_nIndices;
+};
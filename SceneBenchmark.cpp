@@ -0,0 +1,298 @@
+///////////////////////////////////////////////////////////////////////////////
+// scenebenchmark.cpp
+// ============
+// time the scene code that runs without an OpenGL context
+//
+//  Built as its own console program by SceneBenchmark.vcxproj, from the
+//  same sources as the application.  Nothing here creates a window or
+//  calls OpenGL, so it runs anywhere the sources compile.
+//
+//  Usage: SceneBenchmark [mesh.obj]
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ObjMesh.h"
+#include "SceneManager.h"
+
+#include <glm/gtx/transform.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// mesh parsed when no file is passed on the command line
+	const char* const DEFAULT_MESH_FILE = "meshes/spoon.obj";
+
+	// calls timed for each of the fast lookups
+	const int LOOKUP_ITERATIONS = 1000000;
+	// matrices built for each way of building the model matrix
+	const int MATRIX_ITERATIONS = 1000000;
+	// times the mesh file is parsed
+	const int PARSE_ITERATIONS = 50;
+
+	// largest difference allowed between the closed form model
+	// matrix and the product of the separate glm matrices
+	const float MATRIX_TOLERANCE = 1.0e-5f;
+
+	// the same tags the scene loads and looks up
+	const char* const TEXTURE_TAGS[] = { "wood", "counter", "apple", "stainless", "plate", "ceramic" };
+	const int TEXTURE_TAG_COUNT = sizeof(TEXTURE_TAGS) / sizeof(TEXTURE_TAGS[0]);
+	const char* const MATERIAL_TAGS[] = { "wood", "counter", "glass" };
+	const int MATERIAL_TAG_COUNT = sizeof(MATERIAL_TAGS) / sizeof(MATERIAL_TAGS[0]);
+
+	// results are added into this, so the timed calls are not
+	// optimized away
+	volatile float g_Sink = 0.0f;
+
+	// nanoseconds for each of the passed in number of calls since
+	// the passed in time
+	double NanosecondsPerCall(std::chrono::steady_clock::time_point start, int calls)
+	{
+		return(std::chrono::duration<double, std::nano>(
+			std::chrono::steady_clock::now() - start).count() / calls);
+	}
+
+	// the model matrix built from the separate glm matrices, as
+	// SetTransformations() built it before the closed form
+	glm::mat4 ExplicitModelMatrix(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ)
+	{
+		glm::mat4 scale = glm::scale(scaleXYZ);
+		glm::mat4 rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
+		glm::mat4 rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
+		glm::mat4 rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
+		glm::mat4 translation = glm::translate(positionXYZ);
+
+		return(translation * rotationX * rotationY * rotationZ * scale);
+	}
+
+	// transformation values that change with the iteration, so
+	// the compiler cannot fold the matrices into constants
+	void TransformationValues(
+		int i,
+		glm::vec3& scaleXYZ,
+		glm::vec3& rotationDegrees,
+		glm::vec3& positionXYZ)
+	{
+		scaleXYZ = glm::vec3(0.5f + (i % 7) * 0.25f, 1.0f - (i % 5) * 0.3f, 2.0f - (i % 3) * 0.5f);
+		rotationDegrees = glm::vec3((i % 360) * 1.0f - 180.0f, (i % 91) * 4.0f - 180.0f, (i % 37) * 10.0f - 180.0f);
+		positionXYZ = glm::vec3((i % 11) * 0.5f, (i % 13) * -0.25f, (i % 17) * 0.75f);
+	}
+}
+
+/***********************************************************
+ *  SceneBenchmark
+ *
+ *  This class times the SceneManager and ObjMesh code that
+ *  needs no OpenGL context.  It is a friend of SceneManager
+ *  so it can call the private lookup methods directly.
+ ***********************************************************/
+class SceneBenchmark
+{
+public:
+	static bool CheckModelMatrix();
+	static void TimeModelMatrix();
+	static void TimeTextureLookup();
+	static void TimeMaterialLookup();
+	static bool TimeMeshParsing(const char* filename);
+};
+
+/***********************************************************
+ *  CheckModelMatrix()
+ *
+ *  This method is used for checking that the closed form
+ *  model matrix matches translate * rotate * scale built
+ *  from the separate glm matrices, over a spread of scales,
+ *  rotations on all three axes and positions.
+ ***********************************************************/
+bool SceneBenchmark::CheckModelMatrix()
+{
+	float maxError = 0.0f;
+	for (int i = 0; i < 10000; i++)
+	{
+		glm::vec3 scaleXYZ;
+		glm::vec3 rotationDegrees;
+		glm::vec3 positionXYZ;
+		TransformationValues(i, scaleXYZ, rotationDegrees, positionXYZ);
+
+		glm::mat4 closedForm = SceneManager::ComposeModelMatrix(
+			scaleXYZ, rotationDegrees.x, rotationDegrees.y, rotationDegrees.z, positionXYZ);
+		glm::mat4 explicitProduct = ExplicitModelMatrix(
+			scaleXYZ, rotationDegrees.x, rotationDegrees.y, rotationDegrees.z, positionXYZ);
+
+		for (int column = 0; column < 4; column++)
+		{
+			for (int row = 0; row < 4; row++)
+			{
+				float error = std::fabs(closedForm[column][row] - explicitProduct[column][row]);
+				if (error > maxError)
+				{
+					maxError = error;
+				}
+			}
+		}
+	}
+
+	bool bMatches = (maxError <= MATRIX_TOLERANCE);
+	std::cout << "Model matrix closed form vs translate * rotate * scale: largest difference "
+		<< maxError << (bMatches ? ", OK" : ", FAILED") << std::endl;
+
+	return(bMatches);
+}
+
+/***********************************************************
+ *  TimeModelMatrix()
+ *
+ *  This method is used for timing the closed form model
+ *  matrix against the product of the separate glm matrices.
+ ***********************************************************/
+void SceneBenchmark::TimeModelMatrix()
+{
+	float sum = 0.0f;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < MATRIX_ITERATIONS; i++)
+	{
+		glm::vec3 scaleXYZ;
+		glm::vec3 rotationDegrees;
+		glm::vec3 positionXYZ;
+		TransformationValues(i, scaleXYZ, rotationDegrees, positionXYZ);
+		sum += SceneManager::ComposeModelMatrix(
+			scaleXYZ, rotationDegrees.x, rotationDegrees.y, rotationDegrees.z, positionXYZ)[1][2];
+	}
+	double closedFormTime = NanosecondsPerCall(start, MATRIX_ITERATIONS);
+
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < MATRIX_ITERATIONS; i++)
+	{
+		glm::vec3 scaleXYZ;
+		glm::vec3 rotationDegrees;
+		glm::vec3 positionXYZ;
+		TransformationValues(i, scaleXYZ, rotationDegrees, positionXYZ);
+		sum += ExplicitModelMatrix(
+			scaleXYZ, rotationDegrees.x, rotationDegrees.y, rotationDegrees.z, positionXYZ)[1][2];
+	}
+	double explicitTime = NanosecondsPerCall(start, MATRIX_ITERATIONS);
+	g_Sink = g_Sink + sum;
+
+	std::cout << "Model matrix: closed form " << closedFormTime << " ns,"
+		<< " translate * rotate * scale " << explicitTime << " ns" << std::endl;
+}
+
+/***********************************************************
+ *  TimeTextureLookup()
+ *
+ *  This method is used for timing FindTextureSlot() with the
+ *  texture tags the scene registers, without uploading any
+ *  texture data.
+ ***********************************************************/
+void SceneBenchmark::TimeTextureLookup()
+{
+	SceneManager scene(NULL);
+	for (int i = 0; i < TEXTURE_TAG_COUNT; i++)
+	{
+		scene.m_textureIDs[i].tag = TEXTURE_TAGS[i];
+	}
+	scene.m_loadedTextures = TEXTURE_TAG_COUNT;
+
+	int sum = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < LOOKUP_ITERATIONS; i++)
+	{
+		sum += scene.FindTextureSlot(TEXTURE_TAGS[i % TEXTURE_TAG_COUNT]);
+	}
+	double lookupTime = NanosecondsPerCall(start, LOOKUP_ITERATIONS);
+
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < LOOKUP_ITERATIONS; i++)
+	{
+		sum += scene.FindTextureSlot("missing");
+	}
+	double missingTime = NanosecondsPerCall(start, LOOKUP_ITERATIONS);
+	g_Sink = g_Sink + (float)sum;
+
+	std::cout << "FindTextureSlot: " << lookupTime << " ns per lookup, "
+		<< missingTime << " ns for a missing tag" << std::endl;
+}
+
+/***********************************************************
+ *  TimeMaterialLookup()
+ *
+ *  This method is used for timing FindMaterial() with the
+ *  materials the scene defines.
+ ***********************************************************/
+void SceneBenchmark::TimeMaterialLookup()
+{
+	SceneManager scene(NULL);
+	scene.DefineObjectMaterials();
+
+	SceneManager::OBJECT_MATERIAL material;
+	float sum = 0.0f;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < LOOKUP_ITERATIONS; i++)
+	{
+		if (scene.FindMaterial(MATERIAL_TAGS[i % MATERIAL_TAG_COUNT], material))
+		{
+			sum += material.shininess;
+		}
+	}
+	double lookupTime = NanosecondsPerCall(start, LOOKUP_ITERATIONS);
+	g_Sink = g_Sink + sum;
+
+	std::cout << "FindMaterial: " << lookupTime << " ns per lookup" << std::endl;
+}
+
+/***********************************************************
+ *  TimeMeshParsing()
+ *
+ *  This method is used for timing the OBJ parser on the
+ *  passed in file, without creating the OpenGL buffers.
+ ***********************************************************/
+bool SceneBenchmark::TimeMeshParsing(const char* filename)
+{
+	size_t nCorners = ObjMesh::ParseMeshFile(filename);
+	if (nCorners == 0)
+	{
+		return(false);
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < PARSE_ITERATIONS; i++)
+	{
+		nCorners = ObjMesh::ParseMeshFile(filename);
+	}
+	double parseTime = NanosecondsPerCall(start, PARSE_ITERATIONS) / 1.0e6;
+
+	std::cout << "ObjMesh parsing " << filename << ": " << parseTime << " ms, "
+		<< (nCorners / 3) << " triangles" << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  main()
+ *
+ *  Runs each benchmark once.  Fails if the closed form model
+ *  matrix does not match or the mesh file cannot be parsed.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	const char* meshFile = (argc > 1) ? argv[1] : DEFAULT_MESH_FILE;
+
+	bool bSuccess = SceneBenchmark::CheckModelMatrix();
+	SceneBenchmark::TimeModelMatrix();
+	SceneBenchmark::TimeTextureLookup();
+	SceneBenchmark::TimeMaterialLookup();
+	if (SceneBenchmark::TimeMeshParsing(meshFile) == false)
+	{
+		bSuccess = false;
+	}
+
+	return(bSuccess ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -16,14 +16,184 @@
 
 #include <glm/gtx/transform.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <utility>
+
 // declaration of global variables
 namespace
 {
-	const char* g_ModelName = "model";
-	const char* g_ColorValueName = "objectColor";
-	const char* g_TextureValueName = "objectTexture";
-	const char* g_UseTextureName = "bUseTexture";
-	const char* g_UseLightingName = "bUseLighting";
+	// uniform names are kept as strings so that passing them to
+	// the shader manager does not build a temporary for each draw
+	const std::string g_ModelName = "model";
+	const std::string g_ColorValueName = "objectColor";
+	const std::string g_TextureValueName = "objectTexture";
+	const std::string g_UseTextureName = "bUseTexture";
+	const std::string g_UseLightingName = "bUseLighting";
+	const std::string g_UVScaleName = "UVscale";
+	const std::string g_MaterialAmbientColorName = "material.ambientColor";
+	const std::string g_MaterialAmbientStrengthName = "material.ambientStrength";
+	const std::string g_MaterialDiffuseColorName = "material.diffuseColor";
+	const std::string g_MaterialSpecularColorName = "material.specularColor";
+	const std::string g_MaterialShininessName = "material.shininess";
+
+	// default limit on the memory used by loaded textures
+	const size_t DEFAULT_TEXTURE_MEMORY_BUDGET = 256 * 1024 * 1024;
+	// textures are not reduced below this width or height
+	const int MIN_TEXTURE_SIZE = 64;
+
+	/***********************************************************
+	 *  ElapsedMilliseconds()
+	 *
+	 *  Milliseconds passed since the passed in start time.
+	 ***********************************************************/
+	double ElapsedMilliseconds(std::chrono::steady_clock::time_point start)
+	{
+		return(std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - start).count());
+	}
+
+	/***********************************************************
+	 *  MipLevelDimension()
+	 *
+	 *  Width or height of a mipmap level of an image.
+	 ***********************************************************/
+	int MipLevelDimension(int size, int level)
+	{
+		return(std::max(1, size >> level));
+	}
+
+	/***********************************************************
+	 *  MipLevelOffset()
+	 *
+	 *  Offset of a mipmap level in the mipmap levels of an
+	 *  image stored one after another, largest first.
+	 ***********************************************************/
+	size_t MipLevelOffset(int width, int height, int colorChannels, int level)
+	{
+		size_t offset = 0;
+		for (int i = 0; i < level; i++)
+		{
+			offset += (size_t)MipLevelDimension(width, i) * MipLevelDimension(height, i) * colorChannels;
+		}
+		return(offset);
+	}
+
+	/***********************************************************
+	 *  DownsampleImage()
+	 *
+	 *  Reduce an image to half its width and height by averaging
+	 *  each 2x2 block of pixels.  A side of one pixel stays one
+	 *  pixel, and the last row or column of an odd side is
+	 *  averaged with itself.
+	 ***********************************************************/
+	void DownsampleImage(
+		const unsigned char* image,
+		int width,
+		int height,
+		int colorChannels,
+		unsigned char* reduced)
+	{
+		int reducedWidth = MipLevelDimension(width, 1);
+		int reducedHeight = MipLevelDimension(height, 1);
+
+		for (int y = 0; y < reducedHeight; y++)
+		{
+			const unsigned char* row0 = image + (size_t)std::min(y * 2, height - 1) * width * colorChannels;
+			const unsigned char* row1 = image + (size_t)std::min(y * 2 + 1, height - 1) * width * colorChannels;
+			unsigned char* out = reduced + (size_t)y * reducedWidth * colorChannels;
+			for (int x = 0; x < reducedWidth; x++)
+			{
+				int left = std::min(x * 2, width - 1) * colorChannels;
+				int right = std::min(x * 2 + 1, width - 1) * colorChannels;
+				for (int c = 0; c < colorChannels; c++)
+				{
+					out[x * colorChannels + c] = (unsigned char)
+						((row0[left + c] + row0[right + c] + row1[left + c] + row1[right + c] + 2) / 4);
+				}
+			}
+		}
+	}
+
+	/***********************************************************
+	 *  DecodeImage()
+	 *
+	 *  Read and decode the image data from an image file, and
+	 *  build all of its mipmap levels.  This only uses the CPU,
+	 *  so it can run on a worker thread, but the stb_image
+	 *  vertical flip must be set beforehand.
+	 ***********************************************************/
+	SceneManager::DECODED_IMAGE DecodeImage(const char* filename)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		SceneManager::DECODED_IMAGE decoded;
+		decoded.width = 0;
+		decoded.height = 0;
+		decoded.colorChannels = 0;
+		decoded.mipLevelCount = 0;
+		unsigned char* image = stbi_load(
+			filename,
+			&decoded.width,
+			&decoded.height,
+			&decoded.colorChannels,
+			0);
+
+		if (image != NULL)
+		{
+			int width = decoded.width;
+			int height = decoded.height;
+			int colorChannels = decoded.colorChannels;
+
+			decoded.mipLevelCount = 1;
+			while ((MipLevelDimension(width, decoded.mipLevelCount - 1) > 1) ||
+				(MipLevelDimension(height, decoded.mipLevelCount - 1) > 1))
+			{
+				decoded.mipLevelCount++;
+			}
+
+			decoded.mipLevels.resize(MipLevelOffset(width, height, colorChannels, decoded.mipLevelCount));
+			memcpy(decoded.mipLevels.data(), image, (size_t)width * height * colorChannels);
+			stbi_image_free(image);
+
+			for (int level = 1; level < decoded.mipLevelCount; level++)
+			{
+				DownsampleImage(
+					decoded.mipLevels.data() + MipLevelOffset(width, height, colorChannels, level - 1),
+					MipLevelDimension(width, level - 1),
+					MipLevelDimension(height, level - 1),
+					colorChannels,
+					decoded.mipLevels.data() + MipLevelOffset(width, height, colorChannels, level));
+			}
+		}
+		decoded.decodeMilliseconds = ElapsedMilliseconds(start);
+
+		return(decoded);
+	}
+
+	/***********************************************************
+	 *  TextureMemorySize()
+	 *
+	 *  Estimate the memory used by a texture and its mipmaps.
+	 *  Drivers store RGB8 textures with four bytes per texel,
+	 *  so four bytes are counted for every format.
+	 ***********************************************************/
+	size_t TextureMemorySize(int width, int height)
+	{
+		size_t bytes = 0;
+		while (true)
+		{
+			bytes += (size_t)width * height * 4;
+			if ((width == 1) && (height == 1))
+				break;
+			width = (width > 1) ? width / 2 : 1;
+			height = (height > 1) ? height / 2 : 1;
+		}
+		return(bytes);
+	}
 }
 
 /***********************************************************
@@ -35,6 +205,12 @@ SceneManager::SceneManager(ShaderManager *pShaderManager)
 {
 	m_pShaderManager = pShaderManager;
 	m_basicMeshes = new ShapeMeshes();
+	m_loadedTextures = 0;
+	m_textureMemoryUsed = 0;
+	m_textureMemoryBudget = DEFAULT_TEXTURE_MEMORY_BUDGET;
+	m_frameCount = 0;
+	m_frameStats = FRAME_STATS();
+	InvalidateShaderState();
 }
 
 /***********************************************************
@@ -44,74 +220,155 @@ SceneManager::SceneManager(ShaderManager *pShaderManager)
  ***********************************************************/
 SceneManager::~SceneManager()
 {
+	DestroyGLTextures();
+
 	m_pShaderManager = NULL;
 	delete m_basicMeshes;
 	m_basicMeshes = NULL;
 }
 
 /***********************************************************
- *  CreateGLTexture()
+ *  UploadGLTexture()
  *
- *  This method is used for loading textures from image files,
- *  configuring the texture mapping parameters in OpenGL,
- *  generating the mipmaps, and loading the read texture into
- *  the next available texture slot in memory.
+ *  This method is used for creating an OpenGL texture from
+ *  the mipmap levels of a loaded texture kept in memory,
+ *  starting at the passed in level, and configuring the
+ *  texture mapping parameters.
  ***********************************************************/
-bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
+GpuResource SceneManager::UploadGLTexture(const TEXTURE_INFO& info, int baseLevel)
 {
-	int width = 0;
-	int height = 0;
-	int colorChannels = 0;
-	GLuint textureID = 0;
+	GpuResource texture = GpuResource::Create(GpuResource::TEXTURE);
+	texture.SetMemorySize(TextureMemorySize(
+		MipLevelDimension(info.width, baseLevel),
+		MipLevelDimension(info.height, baseLevel)));
+	glBindTexture(GL_TEXTURE_2D, texture.Get());
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters, sampling from the mipmaps
+	// so that distant surfaces read the smaller levels
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, info.mipLevelCount - 1 - baseLevel);
+
+	// rows of the smaller RGB levels are not padded to four bytes
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	// RGBA images support transparency
+	GLint internalFormat = (info.colorChannels == 3) ? GL_RGB8 : GL_RGBA8;
+	GLenum format = (info.colorChannels == 3) ? GL_RGB : GL_RGBA;
+	for (int level = baseLevel; level < info.mipLevelCount; level++)
+	{
+		glTexImage2D(
+			GL_TEXTURE_2D,
+			level - baseLevel,
+			internalFormat,
+			MipLevelDimension(info.width, level),
+			MipLevelDimension(info.height, level),
+			0,
+			format,
+			GL_UNSIGNED_BYTE,
+			info.mipLevels.data() + MipLevelOffset(info.width, info.height, info.colorChannels, level));
+	}
 
-	// indicate to always flip images vertically when loaded
-	stbi_set_flip_vertically_on_load(true);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
-	// try to parse the image data from the specified image file
-	unsigned char* image = stbi_load(
-		filename,
-		&width,
-		&height,
-		&colorChannels,
-		0);
+	return(texture);
+}
+
+/***********************************************************
+ *  SetTextureBaseLevel()
+ *
+ *  This method is used for uploading a loaded texture again
+ *  starting at the passed in mipmap level, and binding it to
+ *  the texture unit of its slot in place of the old one.
+ ***********************************************************/
+void SceneManager::SetTextureBaseLevel(int slot, int baseLevel)
+{
+	TEXTURE_INFO& texture = m_textureIDs[slot];
+
+	glActiveTexture(GL_TEXTURE0 + slot);
+	texture.texture = UploadGLTexture(texture, baseLevel);
+
+	m_textureMemoryUsed -= texture.memorySize;
+	texture.baseLevel = baseLevel;
+	texture.memorySize = texture.texture.GetMemorySize();
+	m_textureMemoryUsed += texture.memorySize;
+}
+
+/***********************************************************
+ *  CreateGLTexture()
+ *
+ *  This method is used for creating a texture from the
+ *  mipmap levels already decoded from the passed in file,
+ *  and loading it into the next available texture slot in
+ *  memory.  The mipmap levels are kept, so the texture can
+ *  be reduced and restored later without reading it back.
+ *
+ *  If the texture does not fit in the texture memory budget,
+ *  the top mipmap levels of the least recently used textures
+ *  are dropped first, and then those of the new texture.
+ *  While the scene loads no texture has been drawn yet, so
+ *  the largest ones are reduced first.
+ ***********************************************************/
+bool SceneManager::CreateGLTexture(DECODED_IMAGE& decoded, const char* filename, const char* tag)
+{
+	int width = decoded.width;
+	int height = decoded.height;
+	int colorChannels = decoded.colorChannels;
+
+	if (m_loadedTextures >= MAX_TEXTURES)
+	{
+		std::cout << "No free texture slot for image:" << filename << std::endl;
+		return false;
+	}
 
 	// if the image was successfully read from the image file
-	if (image)
+	if (decoded.mipLevelCount > 0)
 	{
 		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
 
-		glGenTextures(1, &textureID);
-		glBindTexture(GL_TEXTURE_2D, textureID);
-
-		// set the texture wrapping parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// if the loaded image is in RGB format
-		if (colorChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		// if the loaded image is in RGBA format - it supports transparency
-		else if (colorChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-		else
+		if ((colorChannels != 3) && (colorChannels != 4))
 		{
 			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
 			return false;
 		}
 
-		// generate the texture mipmaps for mapping textures to lower resolutions
-		glGenerateMipmap(GL_TEXTURE_2D);
+		// make room within the budget by reducing other textures
+		while ((m_textureMemoryUsed + TextureMemorySize(width, height) > m_textureMemoryBudget) &&
+			(ReduceLeastRecentlyUsedTexture() == true))
+		{
+		}
 
-		// free the image data from local memory
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+		// start the new texture at a smaller level if it still
+		// does not fit
+		int baseLevel = 0;
+		while ((m_textureMemoryUsed + TextureMemorySize(
+				MipLevelDimension(width, baseLevel),
+				MipLevelDimension(height, baseLevel)) > m_textureMemoryBudget) &&
+			(MipLevelDimension(width, baseLevel + 1) >= MIN_TEXTURE_SIZE) &&
+			(MipLevelDimension(height, baseLevel + 1) >= MIN_TEXTURE_SIZE))
+		{
+			baseLevel++;
+		}
+		if (baseLevel > 0)
+		{
+			std::cout << "Reduced image to fit the texture memory budget:" << filename << ", width:" << MipLevelDimension(width, baseLevel) << ", height:" << MipLevelDimension(height, baseLevel) << std::endl;
+		}
 
 		// register the loaded texture and associate it with the special tag string
-		m_textureIDs[m_loadedTextures].ID = textureID;
-		m_textureIDs[m_loadedTextures].tag = tag;
+		TEXTURE_INFO& texture = m_textureIDs[m_loadedTextures];
+		texture.tag = tag;
+		texture.width = width;
+		texture.height = height;
+		texture.colorChannels = colorChannels;
+		texture.mipLevels = std::move(decoded.mipLevels);
+		texture.mipLevelCount = decoded.mipLevelCount;
+		texture.baseLevel = 0;
+		texture.memorySize = 0;
+		texture.lastUsedFrame = m_frameCount;
+		SetTextureBaseLevel(m_loadedTextures, baseLevel);
 		m_loadedTextures++;
 
 		return true;
@@ -123,6 +380,122 @@ bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
 	return false;
 }
 
+/***********************************************************
+ *  ReduceLeastRecentlyUsedTexture()
+ *
+ *  This method is used for freeing texture memory by dropping
+ *  the top mipmap level of the least recently used texture
+ *  that is still larger than the minimum size.  The texture
+ *  is uploaded again from its kept mipmap levels.  Returns
+ *  false when no texture can be reduced any further.
+ ***********************************************************/
+bool SceneManager::ReduceLeastRecentlyUsedTexture()
+{
+	int slot = -1;
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		const TEXTURE_INFO& texture = m_textureIDs[i];
+		if ((MipLevelDimension(texture.width, texture.baseLevel + 1) < MIN_TEXTURE_SIZE) ||
+			(MipLevelDimension(texture.height, texture.baseLevel + 1) < MIN_TEXTURE_SIZE))
+		{
+			continue;
+		}
+
+		// oldest use first, and the larger texture on a tie
+		if ((slot < 0) ||
+			(texture.lastUsedFrame < m_textureIDs[slot].lastUsedFrame) ||
+			((texture.lastUsedFrame == m_textureIDs[slot].lastUsedFrame) &&
+			 (texture.memorySize > m_textureIDs[slot].memorySize)))
+		{
+			slot = i;
+		}
+	}
+
+	if (slot < 0)
+	{
+		return(false);
+	}
+
+	const TEXTURE_INFO& texture = m_textureIDs[slot];
+	SetTextureBaseLevel(slot, texture.baseLevel + 1);
+
+	std::cout << "Reduced texture to fit the texture memory budget:" << texture.tag
+		<< ", width:" << MipLevelDimension(texture.width, texture.baseLevel)
+		<< ", height:" << MipLevelDimension(texture.height, texture.baseLevel) << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  RestoreMostRecentlyUsedTexture()
+ *
+ *  This method is used for giving back the top mipmap level
+ *  dropped from the most recently used reduced texture, if
+ *  the larger texture fits in the texture memory budget.
+ *  Returns false when no texture can be restored.
+ ***********************************************************/
+bool SceneManager::RestoreMostRecentlyUsedTexture()
+{
+	int slot = -1;
+	for (int i = 0; i < m_loadedTextures; i++)
+	{
+		const TEXTURE_INFO& texture = m_textureIDs[i];
+		if (texture.baseLevel == 0)
+		{
+			continue;
+		}
+
+		size_t restoredSize = TextureMemorySize(
+			MipLevelDimension(texture.width, texture.baseLevel - 1),
+			MipLevelDimension(texture.height, texture.baseLevel - 1));
+		if (m_textureMemoryUsed - texture.memorySize + restoredSize > m_textureMemoryBudget)
+		{
+			continue;
+		}
+
+		if ((slot < 0) || (texture.lastUsedFrame > m_textureIDs[slot].lastUsedFrame))
+		{
+			slot = i;
+		}
+	}
+
+	if (slot < 0)
+	{
+		return(false);
+	}
+
+	const TEXTURE_INFO& texture = m_textureIDs[slot];
+	SetTextureBaseLevel(slot, texture.baseLevel - 1);
+
+	std::cout << "Restored texture within the texture memory budget:" << texture.tag
+		<< ", width:" << MipLevelDimension(texture.width, texture.baseLevel)
+		<< ", height:" << MipLevelDimension(texture.height, texture.baseLevel) << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  UpdateTextureResidency()
+ *
+ *  This method is used for keeping the loaded textures within
+ *  the texture memory budget as it changes.  Over the budget
+ *  the least recently used texture is reduced by one level,
+ *  and with room to spare the most recently used reduced
+ *  texture gets a level back.  Only one texture is uploaded
+ *  per call, so the uploads are spread over frames.
+ ***********************************************************/
+void SceneManager::UpdateTextureResidency()
+{
+	if (m_textureMemoryUsed > m_textureMemoryBudget)
+	{
+		ReduceLeastRecentlyUsedTexture();
+	}
+	else
+	{
+		RestoreMostRecentlyUsedTexture();
+	}
+}
+
 /***********************************************************
  *  BindGLTextures()
  *
@@ -135,7 +508,7 @@ void SceneManager::BindGLTextures()
 	{
 		// bind textures on corresponding texture units
 		glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
+		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].texture.Get());
 	}
 }
 
@@ -149,8 +522,11 @@ void SceneManager::DestroyGLTextures()
 {
 	for (int i = 0; i < m_loadedTextures; i++)
 	{
-		glGenTextures(1, &m_textureIDs[i].ID);
+		m_textureIDs[i].texture.Reset();
+		m_textureIDs[i].mipLevels = std::vector<unsigned char>();
 	}
+	m_loadedTextures = 0;
+	m_textureMemoryUsed = 0;
 }
 
 /***********************************************************
@@ -159,7 +535,7 @@ void SceneManager::DestroyGLTextures()
  *  This method is used for getting an ID for the previously
  *  loaded texture bitmap associated with the passed in tag.
  ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
+int SceneManager::FindTextureID(const char* tag)
 {
 	int textureID = -1;
 	int index = 0;
@@ -169,7 +545,7 @@ int SceneManager::FindTextureID(std::string tag)
 	{
 		if (m_textureIDs[index].tag.compare(tag) == 0)
 		{
-			textureID = m_textureIDs[index].ID;
+			textureID = m_textureIDs[index].texture.Get();
 			bFound = true;
 		}
 		else
@@ -185,7 +561,7 @@ int SceneManager::FindTextureID(std::string tag)
  *  This method is used for getting a slot index for the previously
  *  loaded texture bitmap associated with the passed in tag.
  ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
+int SceneManager::FindTextureSlot(const char* tag)
 {
 	int textureSlot = -1;
 	int index = 0;
@@ -211,7 +587,7 @@ int SceneManager::FindTextureSlot(std::string tag)
  *  This method is used for getting a material from the previously
  *  defined materials list that is associated with the passed in tag.
  ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
+bool SceneManager::FindMaterial(const char* tag, OBJECT_MATERIAL& material)
 {
 	if (m_objectMaterials.size() == 0)
 	{
@@ -237,7 +613,62 @@ bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
 		}
 	}
 
-	return(true);
+	return(bFound);
+}
+
+/***********************************************************
+ *  ComposeModelMatrix()
+ *
+ *  This method is used for building the model matrix from
+ *  the passed in transformation values.
+ *
+ *  The model matrix is the same as
+ *  translation * rotationX * rotationY * rotationZ * scale,
+ *  but it is written out in closed form so that it costs
+ *  three sin/cos pairs and a few dozen multiplies instead
+ *  of four general 4x4 matrix products.
+ ***********************************************************/
+glm::mat4 SceneManager::ComposeModelMatrix(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	// variables for this method
+	glm::mat4 modelView;
+
+	float xRadians = glm::radians(XrotationDegrees);
+	float yRadians = glm::radians(YrotationDegrees);
+	float zRadians = glm::radians(ZrotationDegrees);
+	float cx = std::cos(xRadians);
+	float sx = std::sin(xRadians);
+	float cy = std::cos(yRadians);
+	float sy = std::sin(yRadians);
+	float cz = std::cos(zRadians);
+	float sz = std::sin(zRadians);
+
+	// each column is a column of rotationX * rotationY * rotationZ
+	// multiplied by the matching scale value
+	modelView[0] = glm::vec4(
+		cy * cz * scaleXYZ.x,
+		(cx * sz + sx * sy * cz) * scaleXYZ.x,
+		(sx * sz - cx * sy * cz) * scaleXYZ.x,
+		0.0f);
+	modelView[1] = glm::vec4(
+		-cy * sz * scaleXYZ.y,
+		(cx * cz - sx * sy * sz) * scaleXYZ.y,
+		(sx * cz + cx * sy * sz) * scaleXYZ.y,
+		0.0f);
+	modelView[2] = glm::vec4(
+		sy * scaleXYZ.z,
+		-sx * cy * scaleXYZ.z,
+		cx * cy * scaleXYZ.z,
+		0.0f);
+	// the translation goes in the last column
+	modelView[3] = glm::vec4(positionXYZ, 1.0f);
+
+	return(modelView);
 }
 
 /***********************************************************
@@ -253,28 +684,14 @@ void SceneManager::SetTransformations(
 	float ZrotationDegrees,
 	glm::vec3 positionXYZ)
 {
-	// variables for this method
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
-
-	// set the scale value in the transform buffer
-	scale = glm::scale(scaleXYZ);
-	// set the rotation values in the transform buffer
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	// set the translation value in the transform buffer
-	translation = glm::translate(positionXYZ);
-
-	modelView = translation * rotationX * rotationY * rotationZ * scale;
-
 	if (NULL != m_pShaderManager)
 	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
+		ApplyModelValue(ComposeModelMatrix(
+			scaleXYZ,
+			XrotationDegrees,
+			YrotationDegrees,
+			ZrotationDegrees,
+			positionXYZ));
 	}
 }
 
@@ -300,8 +717,8 @@ void SceneManager::SetShaderColor(
 
 	if (NULL != m_pShaderManager)
 	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
+		ApplyUseTextureValue(false);
+		ApplyColorValue(currentColor);
 	}
 }
 
@@ -312,15 +729,21 @@ void SceneManager::SetShaderColor(
  *  associated with the passed in ID into the shader.
  ***********************************************************/
 void SceneManager::SetShaderTexture(
-	std::string textureTag)
+	const char* textureTag)
 {
 	if (NULL != m_pShaderManager)
 	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
+		ApplyUseTextureValue(true);
 
 		int textureID = -1;
 		textureID = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureID);
+		ApplyTextureSlotValue(textureID);
+
+		// remember the use for least recently used reduction
+		if (textureID >= 0)
+		{
+			m_textureIDs[textureID].lastUsedFrame = m_frameCount;
+		}
 	}
 }
 
@@ -334,7 +757,7 @@ void SceneManager::SetTextureUVScale(float u, float v)
 {
 	if (NULL != m_pShaderManager)
 	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
+		ApplyUVScaleValue(glm::vec2(u, v));
 	}
 }
 
@@ -345,7 +768,7 @@ void SceneManager::SetTextureUVScale(float u, float v)
  *  into the shader.
  ***********************************************************/
 void SceneManager::SetShaderMaterial(
-	std::string materialTag)
+	const char* materialTag)
 {
 	if (m_objectMaterials.size() > 0)
 	{
@@ -355,17 +778,163 @@ void SceneManager::SetShaderMaterial(
 		bReturn = FindMaterial(materialTag, material);
 		if (bReturn == true)
 		{
-			m_pShaderManager->setVec3Value("material.ambientColor", material.ambientColor);
-			m_pShaderManager->setFloatValue("material.ambientStrength", material.ambientStrength);
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
+			ApplyMaterialValue(material);
 		}
 	}
 }
 
 
+/***********************************************************
+ *  CountUniformUpload()
+ *
+ *  This method is used for adding uniform uploads to the
+ *  counters for the current frame.
+ ***********************************************************/
+void SceneManager::CountUniformUpload(size_t bytes, unsigned int count)
+{
+	m_frameStats.uniformUploads += count;
+	m_frameStats.uniformBytes += bytes;
+}
+
+/***********************************************************
+ *  InvalidateShaderState()
+ *
+ *  This method is used for forgetting the cached uniform
+ *  values, so that the next value of each is always sent.
+ *  Call it if anything else changes these uniforms or the
+ *  active shader program.
+ ***********************************************************/
+void SceneManager::InvalidateShaderState()
+{
+	m_shaderState.bModelSet = false;
+	m_shaderState.bUseTextureSet = false;
+	m_shaderState.bTextureSlotSet = false;
+	m_shaderState.bColorSet = false;
+	m_shaderState.bUVScaleSet = false;
+	m_shaderState.bMaterialSet = false;
+}
+
+/***********************************************************
+ *  ApplyModelValue()
+ *
+ *  The Apply*Value() methods send a uniform value to the
+ *  shader only when it differs from the last value sent,
+ *  and count the uploads that were filtered out.
+ ***********************************************************/
+void SceneManager::ApplyModelValue(const glm::mat4& model)
+{
+	if (m_shaderState.bModelSet && (m_shaderState.model == model))
+	{
+		m_frameStats.uniformUploadsFiltered++;
+		return;
+	}
+
+	m_pShaderManager->setMat4Value(g_ModelName, model);
+	CountUniformUpload(sizeof(glm::mat4));
+	m_shaderState.model = model;
+	m_shaderState.bModelSet = true;
+}
+
+/***********************************************************
+ *  ApplyUseTextureValue()
+ ***********************************************************/
+void SceneManager::ApplyUseTextureValue(bool bUseTexture)
+{
+	if (m_shaderState.bUseTextureSet && (m_shaderState.bUseTexture == bUseTexture))
+	{
+		m_frameStats.uniformUploadsFiltered++;
+		return;
+	}
+
+	m_pShaderManager->setIntValue(g_UseTextureName, bUseTexture);
+	CountUniformUpload(sizeof(int));
+	m_shaderState.bUseTexture = bUseTexture;
+	m_shaderState.bUseTextureSet = true;
+}
+
+/***********************************************************
+ *  ApplyTextureSlotValue()
+ ***********************************************************/
+void SceneManager::ApplyTextureSlotValue(int textureSlot)
+{
+	if (m_shaderState.bTextureSlotSet && (m_shaderState.textureSlot == textureSlot))
+	{
+		m_frameStats.uniformUploadsFiltered++;
+		return;
+	}
+
+	m_pShaderManager->setSampler2DValue(g_TextureValueName, textureSlot);
+	CountUniformUpload(sizeof(int));
+	m_frameStats.textureChanges++;
+	m_shaderState.textureSlot = textureSlot;
+	m_shaderState.bTextureSlotSet = true;
+}
+
+/***********************************************************
+ *  ApplyColorValue()
+ ***********************************************************/
+void SceneManager::ApplyColorValue(const glm::vec4& color)
+{
+	if (m_shaderState.bColorSet && (m_shaderState.color == color))
+	{
+		m_frameStats.uniformUploadsFiltered++;
+		return;
+	}
+
+	m_pShaderManager->setVec4Value(g_ColorValueName, color);
+	CountUniformUpload(sizeof(glm::vec4));
+	m_shaderState.color = color;
+	m_shaderState.bColorSet = true;
+}
+
+/***********************************************************
+ *  ApplyUVScaleValue()
+ ***********************************************************/
+void SceneManager::ApplyUVScaleValue(const glm::vec2& uvScale)
+{
+	if (m_shaderState.bUVScaleSet && (m_shaderState.uvScale == uvScale))
+	{
+		m_frameStats.uniformUploadsFiltered++;
+		return;
+	}
+
+	m_pShaderManager->setVec2Value(g_UVScaleName, uvScale);
+	CountUniformUpload(sizeof(glm::vec2));
+	m_shaderState.uvScale = uvScale;
+	m_shaderState.bUVScaleSet = true;
+}
+
+/***********************************************************
+ *  ApplyMaterialValue()
+ ***********************************************************/
+void SceneManager::ApplyMaterialValue(const OBJECT_MATERIAL& material)
+{
+	const OBJECT_MATERIAL& current = m_shaderState.material;
+	if (m_shaderState.bMaterialSet &&
+		(current.ambientColor == material.ambientColor) &&
+		(current.ambientStrength == material.ambientStrength) &&
+		(current.diffuseColor == material.diffuseColor) &&
+		(current.specularColor == material.specularColor) &&
+		(current.shininess == material.shininess))
+	{
+		m_frameStats.uniformUploadsFiltered += 5;
+		return;
+	}
 
+	m_pShaderManager->setVec3Value(g_MaterialAmbientColorName, material.ambientColor);
+	m_pShaderManager->setFloatValue(g_MaterialAmbientStrengthName, material.ambientStrength);
+	m_pShaderManager->setVec3Value(g_MaterialDiffuseColorName, material.diffuseColor);
+	m_pShaderManager->setVec3Value(g_MaterialSpecularColorName, material.specularColor);
+	m_pShaderManager->setFloatValue(g_MaterialShininessName, material.shininess);
+	CountUniformUpload(sizeof(glm::vec3) * 3 + sizeof(float) * 2, 5);
+
+	m_shaderState.material.ambientColor = material.ambientColor;
+	m_shaderState.material.ambientStrength = material.ambientStrength;
+	m_shaderState.material.diffuseColor = material.diffuseColor;
+	m_shaderState.material.specularColor = material.specularColor;
+	m_shaderState.material.shininess = material.shininess;
+	m_shaderState.bMaterialSet = true;
+}
 
 /***********************************************************
  *  PrepareScene()
@@ -376,33 +945,142 @@ void SceneManager::SetShaderMaterial(
  ***********************************************************/
 void SceneManager::PrepareScene()
 {
-	
+	// image files for the scene textures, with their tags
+	const char* const textureFiles[][2] = {
+		{ "textures/wood.jpg", "wood" }, //My Loaded Image
+		{ "textures/counter.jpg", "counter" }, // My Loaded Image
+		{ "textures/apple.jpg", "apple" }, // My Loaded Image
+		{ "textures/stainless.jpg", "stainless" }, // My Loaded Image
+		{ "textures/plate.jpg", "plate" }, // My Loaded Image
+		{ "textures/ceramic.jpg", "ceramic" } }; // My Loaded Image
+	const int textureCount = sizeof(textureFiles) / sizeof(textureFiles[0]);
+
+	// decode the images on worker threads, the flip setting is
+	// global in stb_image so it is set once before they start
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	stbi_set_flip_vertically_on_load(true);
+	std::future<DECODED_IMAGE> decodedImages[textureCount];
+	for (int i = 0; i < textureCount; i++)
+	{
+		decodedImages[i] = std::async(std::launch::async, DecodeImage, textureFiles[i][0]);
+	}
 
+	// generate the meshes on this thread while the images decode
+	std::chrono::steady_clock::time_point phaseStart = std::chrono::steady_clock::now();
 	m_basicMeshes->LoadPlaneMesh();
 	m_basicMeshes->LoadTaperedCylinderMesh();
 	m_basicMeshes->LoadSphereMesh();
 	m_basicMeshes->LoadCylinderMesh();
 	m_basicMeshes->LoadTorusMesh();
+	m_spoonMesh.LoadMesh("meshes/spoon.obj");
+	double meshMilliseconds = ElapsedMilliseconds(phaseStart);
 
-	CreateGLTexture("textures/wood.jpg", "wood"); //My Loaded Image
-	CreateGLTexture("textures/counter.jpg", "counter"); // My Loaded Image
-	CreateGLTexture("textures/apple.jpg", "apple"); // My Loaded Image
-	CreateGLTexture("textures/stainless.jpg", "stainless"); // My Loaded Image
-	CreateGLTexture("textures/plate.jpg", "plate"); // My Loaded Image
-	CreateGLTexture("textures/ceramic.jpg", "ceramic"); // My Loaded Image
-	
+	phaseStart = std::chrono::steady_clock::now();
 	DefineObjectMaterials();
 	SetupSceneLights();
+	// the transparent pass blends with the alpha of each object
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	double lightingMilliseconds = ElapsedMilliseconds(phaseStart);
+
+	// upload each texture on this thread, the GL context thread,
+	// as soon as its image has been decoded
+	double waitMilliseconds = 0.0;
+	double decodeMilliseconds = 0.0;
+	phaseStart = std::chrono::steady_clock::now();
+	for (int i = 0; i < textureCount; i++)
+	{
+		std::chrono::steady_clock::time_point waitStart = std::chrono::steady_clock::now();
+		DECODED_IMAGE decoded = decodedImages[i].get();
+		waitMilliseconds += ElapsedMilliseconds(waitStart);
+		decodeMilliseconds += decoded.decodeMilliseconds;
 
+		CreateGLTexture(decoded, textureFiles[i][0], textureFiles[i][1]);
+	}
+	double textureMilliseconds = ElapsedMilliseconds(phaseStart) - waitMilliseconds;
+	std::cout << "Texture memory used:" << (m_textureMemoryUsed / (1024 * 1024)) << "MB of " << (m_textureMemoryBudget / (1024 * 1024)) << "MB budget" << std::endl;
+
+	std::cout << "Scene prepared in " << ElapsedMilliseconds(start) << " ms:"
+		<< " meshes " << meshMilliseconds << " ms,"
+		<< " materials and lights " << lightingMilliseconds << " ms,"
+		<< " image decoding " << decodeMilliseconds << " ms on worker threads"
+		<< " (" << waitMilliseconds << " ms waited),"
+		<< " texture uploads " << textureMilliseconds << " ms" << std::endl;
 }
 
 /***********************************************************
  *  RenderScene()
  *
- *  This method is used for rendering the 3D scene by
- *  transforming and drawing the basic 3D shapes.
+ *  This method is used for rendering the 3D scene in passes.
+ *  The opaque pass draws with blending off.  The transparent
+ *  pass then blends over it with depth writes off, so the
+ *  opaque objects behind a transparent one still show.
  ***********************************************************/
 void SceneManager::RenderScene()
+{
+	m_frameCount++;
+	m_frameStats = FRAME_STATS();
+
+	RenderOpaqueObjects();
+
+	glEnable(GL_BLEND);
+	glDepthMask(GL_FALSE);
+	RenderTransparentObjects();
+	glDepthMask(GL_TRUE);
+	glDisable(GL_BLEND);
+}
+
+/***********************************************************
+ *  DrawSceneMesh()
+ *
+ *  This method is used for drawing one of the scene meshes
+ *  and counting the GL draw calls it issues.  The cylinder
+ *  meshes draw the bottom, the top and the sides separately,
+ *  so each part drawn is one call.
+ ***********************************************************/
+void SceneManager::DrawSceneMesh(
+	SCENE_MESH mesh,
+	bool bDrawBottom,
+	bool bDrawTop,
+	bool bDrawSides)
+{
+	unsigned int cylinderDraws = (bDrawBottom ? 1 : 0) + (bDrawTop ? 1 : 0) + (bDrawSides ? 1 : 0);
+
+	switch (mesh)
+	{
+	case PLANE_MESH:
+		m_basicMeshes->DrawPlaneMesh();
+		m_frameStats.drawCalls++;
+		break;
+	case SPHERE_MESH:
+		m_basicMeshes->DrawSphereMesh();
+		m_frameStats.drawCalls++;
+		break;
+	case CYLINDER_MESH:
+		m_basicMeshes->DrawCylinderMesh(bDrawBottom, bDrawTop, bDrawSides);
+		m_frameStats.drawCalls += cylinderDraws;
+		break;
+	case TAPERED_CYLINDER_MESH:
+		m_basicMeshes->DrawTaperedCylinderMesh(bDrawBottom, bDrawTop, bDrawSides);
+		m_frameStats.drawCalls += cylinderDraws;
+		break;
+	case TORUS_MESH:
+		m_basicMeshes->DrawTorusMesh();
+		m_frameStats.drawCalls++;
+		break;
+	case SPOON_MESH:
+		m_spoonMesh.DrawMesh();
+		m_frameStats.drawCalls++;
+		break;
+	}
+}
+
+/***********************************************************
+ *  RenderOpaqueObjects()
+ *
+ *  This method is used for transforming and drawing the
+ *  basic 3D shapes that completely hide what is behind them.
+ ***********************************************************/
+void SceneManager::RenderOpaqueObjects()
 {
 	glm::vec3 scaleXYZ;
 	float XrotationDegrees = 0.0f;
@@ -421,11 +1099,21 @@ void SceneManager::RenderScene()
 	SetShaderTexture("counter");
 	SetTextureUVScale(1.0f, 1.0f);
 	SetShaderMaterial("wood");
-	m_basicMeshes->DrawPlaneMesh();
+	DrawSceneMesh(PLANE_MESH);
 
 	// ========== Bowl Setup ==========
 	float bowlTilt = 10.0f;
 
+	// Bowl Outer Shell (Inverted Sphere)
+	// drawn first so it can hide the inner scoop
+	scaleXYZ = glm::vec3(2.0f, -1.0f, 2.0f);
+	positionXYZ = glm::vec3(0.0f, 0.9f, 0.0f);
+	SetTransformations(scaleXYZ, bowlTilt, 0.0f, 0.0f, positionXYZ);
+	SetShaderTexture("wood");
+	SetShaderMaterial("wood");
+	SetTextureUVScale(1.0f, 1.0f);
+	DrawSceneMesh(SPHERE_MESH);
+
 	// Bowl Base (Tapered Cylinder)
 	scaleXYZ = glm::vec3(1.85f, 0.15f, 1.85f);
 	XrotationDegrees = bowlTilt;
@@ -434,15 +1122,7 @@ void SceneManager::RenderScene()
 	SetShaderTexture("wood");
 	SetShaderMaterial("wood");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawTaperedCylinderMesh();
-
-	// Bowl Outer Shell (Inverted Sphere)
-	scaleXYZ = glm::vec3(2.0f, -1.0f, 2.0f);
-	positionXYZ = glm::vec3(0.0f, 0.9f, 0.0f);
-	SetTransformations(scaleXYZ, bowlTilt, 0.0f, 0.0f, positionXYZ);
-	SetShaderTexture("wood");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawSphereMesh();
+	DrawSceneMesh(TAPERED_CYLINDER_MESH);
 
 	// Bowl Inner Scoop (Smaller Inverted Sphere)
 	scaleXYZ = glm::vec3(1.65f, -0.95f, 1.65f);
@@ -450,7 +1130,7 @@ void SceneManager::RenderScene()
 	SetTransformations(scaleXYZ, bowlTilt, 0.0f, 0.0f, positionXYZ);
 	SetShaderTexture("wood");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawSphereMesh();
+	DrawSceneMesh(SPHERE_MESH);
 
 	// Bowl Rim (Thin Cylinder)
 	scaleXYZ = glm::vec3(2.05f, 0.05f, 2.05f);
@@ -458,32 +1138,46 @@ void SceneManager::RenderScene()
 	SetTransformations(scaleXYZ, bowlTilt, 0.0f, 0.0f, positionXYZ);
 	SetShaderTexture("wood");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawCylinderMesh();
+	DrawSceneMesh(CYLINDER_MESH);
 
 
 	// ========== Spoon Setup ==========
 
-	// Spoon Handle (Cylinder)
-	scaleXYZ = glm::vec3(0.12f, 1.2f, 0.12f);
-	XrotationDegrees = 90.0f;                      
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = -30.0f;                     
-	positionXYZ = glm::vec3(2.4f, 0.1f, 0.1f);      
-	SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-	SetShaderTexture("wood");
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawCylinderMesh();
-
-	// Spoon Scoop (Sphere Head)
-	scaleXYZ = glm::vec3(0.35f, 0.06f, 0.25f);       
-	XrotationDegrees = 180.0f;                       
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-	positionXYZ = glm::vec3(2.45f, 0.07f, 0.05f);    
-	SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-	SetShaderTexture("wood");                        
-	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawSphereMesh();
+	// Spoon (OBJ model), built from basic shapes below if the
+	// model file could not be loaded
+	if (m_spoonMesh.GetIndexCount() > 0)
+	{
+		scaleXYZ = glm::vec3(1.0f, 1.0f, 1.0f);
+		positionXYZ = glm::vec3(2.45f, 0.07f, 0.05f);
+		SetTransformations(scaleXYZ, 0.0f, -60.0f, 0.0f, positionXYZ);
+		SetShaderTexture("wood");
+		SetTextureUVScale(1.0f, 1.0f);
+		DrawSceneMesh(SPOON_MESH);
+	}
+	else
+	{
+		// Spoon Handle (Cylinder)
+		scaleXYZ = glm::vec3(0.12f, 1.2f, 0.12f);
+		XrotationDegrees = 90.0f;                      
+		YrotationDegrees = 0.0f;
+		ZrotationDegrees = -30.0f;                     
+		positionXYZ = glm::vec3(2.4f, 0.1f, 0.1f);      
+		SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
+		SetShaderTexture("wood");
+		SetTextureUVScale(1.0f, 1.0f);
+		DrawSceneMesh(CYLINDER_MESH);
+
+		// Spoon Scoop (Sphere Head)
+		scaleXYZ = glm::vec3(0.35f, 0.06f, 0.25f);       
+		XrotationDegrees = 180.0f;                       
+		YrotationDegrees = 0.0f;
+		ZrotationDegrees = 0.0f;
+		positionXYZ = glm::vec3(2.45f, 0.07f, 0.05f);    
+		SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
+		SetShaderTexture("wood");                        
+		SetTextureUVScale(1.0f, 1.0f);
+		DrawSceneMesh(SPHERE_MESH);
+	}
 	
 	// --- Mug Body ---
 	scaleXYZ = glm::vec3(0.5f, 0.8f, 0.5f);
@@ -492,7 +1186,7 @@ void SceneManager::RenderScene()
 	SetShaderTexture("ceramic");
 	//SetShaderMaterial("wood");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawCylinderMesh();
+	DrawSceneMesh(CYLINDER_MESH);
 
 	
 	// --- Mug Handle ---
@@ -505,7 +1199,7 @@ void SceneManager::RenderScene()
 	SetShaderTexture("ceramic");
 	//SetShaderMaterial("wood");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawTorusMesh();
+	DrawSceneMesh(TORUS_MESH);
 
 
 	// --- Apple Body ---
@@ -515,7 +1209,7 @@ void SceneManager::RenderScene()
 	SetShaderTexture("apple");
 	//SetShaderMaterial("wood");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawSphereMesh();
+	DrawSceneMesh(SPHERE_MESH);
 
 	// --- Apple Stem ---
 	scaleXYZ = glm::vec3(0.07f, 0.2f, 0.07f); 
@@ -527,7 +1221,7 @@ void SceneManager::RenderScene()
 	SetShaderTexture("wood");
 	//SetShaderMaterial("wood");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawCylinderMesh();
+	DrawSceneMesh(CYLINDER_MESH);
 
 
 	// --- Plate ---
@@ -537,7 +1231,25 @@ void SceneManager::RenderScene()
 	SetShaderTexture("plate");
 	//SetShaderMaterial("wood");
 	SetTextureUVScale(1.0f, 1.0f);
-	m_basicMeshes->DrawCylinderMesh();
+	DrawSceneMesh(CYLINDER_MESH);
+}
+
+/***********************************************************
+ *  RenderTransparentObjects()
+ *
+ *  This method is used for drawing the shapes with alpha
+ *  below one, after all of the opaque shapes.  The scene has
+ *  a single transparent object, so no sorting is needed.
+ ***********************************************************/
+void SceneManager::RenderTransparentObjects()
+{
+	// --- Drinking Glass (open topped cylinder) ---
+	glm::vec3 scaleXYZ = glm::vec3(0.35f, 1.1f, 0.35f);
+	glm::vec3 positionXYZ = glm::vec3(-2.5f, 0.01f, 2.5f);
+	SetTransformations(scaleXYZ, 0.0f, 0.0f, 0.0f, positionXYZ);
+	SetShaderColor(0.85f, 0.92f, 1.0f, 0.3f);
+	SetShaderMaterial("glass");
+	DrawSceneMesh(CYLINDER_MESH, false, true, true);
 }
 
 //*********************Setup Lights ************************* 
@@ -545,7 +1257,7 @@ void SceneManager::RenderScene()
 void SceneManager::SetupSceneLights()
 {
 	// Enable lighting in shader
-	m_pShaderManager->setBoolValue("bUseLighting", true);
+	m_pShaderManager->setBoolValue(g_UseLightingName, true);
 
 	// Light 0  main warm light above 
 	m_pShaderManager->setVec3Value("lightSources[0].position", glm::vec3(-2.0f, 8.0f, 5.5f)); 
@@ -602,4 +1314,13 @@ void SceneManager::DefineObjectMaterials()
 	counterMaterial.shininess = 8.0f;
 	counterMaterial.tag = "counter";
 	m_objectMaterials.push_back(counterMaterial);
+
+	OBJECT_MATERIAL glassMaterial;
+	glassMaterial.ambientColor = glm::vec3(0.3f);
+	glassMaterial.ambientStrength = 0.1f;
+	glassMaterial.diffuseColor = glm::vec3(0.6f);
+	glassMaterial.specularColor = glm::vec3(1.0f);
+	glassMaterial.shininess = 64.0f;
+	glassMaterial.tag = "glass";
+	m_objectMaterials.push_back(glassMaterial);
 }
\ No newline at end of file
@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include "FrameStats.h"
+#include "GpuResource.h"
+#include "ObjMesh.h"
 #include "ShaderManager.h"
 #include "ShapeMeshes.h"
 
@@ -23,6 +26,9 @@
  ***********************************************************/
 class SceneManager
 {
+	// times the methods that need no OpenGL context
+	friend class SceneBenchmark;
+
 public:
 	// constructor
 	SceneManager(ShaderManager* pShaderManager);
@@ -32,7 +38,32 @@ public:
 	struct TEXTURE_INFO
 	{
 		std::string tag;
-		uint32_t ID;
+		GpuResource texture;
+		int width;
+		int height;
+		int colorChannels;
+		// mipmap levels kept in memory, largest first, so the
+		// texture can be uploaded again from any level
+		std::vector<unsigned char> mipLevels;
+		int mipLevelCount;
+		// mipmap level the uploaded texture starts at
+		int baseLevel;
+		// estimated bytes used by the uploaded texture
+		size_t memorySize;
+		// last frame the texture was set into the shader
+		unsigned int lastUsedFrame;
+	};
+
+	// image data decoded from a file, not yet uploaded
+	struct DECODED_IMAGE
+	{
+		// all mipmap levels, largest first
+		std::vector<unsigned char> mipLevels;
+		int mipLevelCount;
+		int width;
+		int height;
+		int colorChannels;
+		double decodeMilliseconds;
 	};
 
 	struct OBJECT_MATERIAL
@@ -48,6 +79,20 @@ public:
 	//  Moved to public so it can be called from main.cpp
 	void BindGLTextures();
 
+	// set the limit on texture memory, textures over it are
+	// reduced as they load and by UpdateTextureResidency()
+	void SetTextureMemoryBudget(size_t bytes) { m_textureMemoryBudget = bytes; }
+	// reduce or restore one texture to follow the budget, call
+	// once per frame outside of the timed scene rendering
+	void UpdateTextureResidency();
+	// estimated bytes used by all loaded textures
+	size_t GetTextureMemoryUsed() const { return m_textureMemoryUsed; }
+	// rendering counters for the last RenderScene() call
+	const FRAME_STATS& GetFrameStats() const { return m_frameStats; }
+	// forget the cached uniform values after the shader program
+	// or its uniforms are changed outside this class
+	void InvalidateShaderState();
+
 	// The following methods are for the students to 
 	// customize for their own 3D scene
 	void PrepareScene();
@@ -56,27 +101,94 @@ public:
 	void DefineObjectMaterials();
 
 private:
+	// number of texture slots that can be loaded
+	static const int MAX_TEXTURES = 16;
+
 	// pointer to shader manager object
 	ShaderManager* m_pShaderManager;
 	// pointer to basic shapes object
 	ShapeMeshes* m_basicMeshes;
+	// spoon model loaded from an OBJ file
+	ObjMesh m_spoonMesh;
 	// total number of loaded textures
 	int m_loadedTextures;
 	// loaded textures info
-	TEXTURE_INFO m_textureIDs[16];
+	TEXTURE_INFO m_textureIDs[MAX_TEXTURES];
+	// estimated bytes used by all loaded textures
+	size_t m_textureMemoryUsed;
+	// limit on the bytes used by loaded textures
+	size_t m_textureMemoryBudget;
+	// number of frames rendered, for least recently used tracking
+	unsigned int m_frameCount;
 	// defined object materials
 	std::vector<OBJECT_MATERIAL> m_objectMaterials;
+	// rendering counters for the current frame
+	FRAME_STATS m_frameStats;
+
+	// last values sent to the shader uniforms, used to skip
+	// uploads that would not change anything
+	struct SHADER_STATE
+	{
+		bool bModelSet;
+		glm::mat4 model;
+		bool bUseTextureSet;
+		bool bUseTexture;
+		bool bTextureSlotSet;
+		int textureSlot;
+		bool bColorSet;
+		glm::vec4 color;
+		bool bUVScaleSet;
+		glm::vec2 uvScale;
+		bool bMaterialSet;
+		OBJECT_MATERIAL material;
+	};
+	SHADER_STATE m_shaderState;
 
-	// load texture images and convert to OpenGL texture data
-	bool CreateGLTexture(const char* filename, std::string tag);
+	// load a decoded texture image into the next texture slot
+	bool CreateGLTexture(DECODED_IMAGE& decoded, const char* filename, const char* tag);
+	// create an OpenGL texture from the kept mipmap levels
+	GpuResource UploadGLTexture(const TEXTURE_INFO& info, int baseLevel);
+	// upload a loaded texture again starting at another level
+	void SetTextureBaseLevel(int slot, int baseLevel);
+	// drop the top mipmap level of the least recently used texture
+	bool ReduceLeastRecentlyUsedTexture();
+	// restore a level of the most recently used reduced texture
+	bool RestoreMostRecentlyUsedTexture();
 	// free the loaded OpenGL textures
 	void DestroyGLTextures();
+	// meshes the scene is built from
+	enum SCENE_MESH
+	{
+		PLANE_MESH,
+		SPHERE_MESH,
+		CYLINDER_MESH,
+		TAPERED_CYLINDER_MESH,
+		TORUS_MESH,
+		SPOON_MESH
+	};
+	// draw a mesh and count the GL draw calls it issues, the
+	// flags choose the parts drawn for the cylinder meshes
+	void DrawSceneMesh(
+		SCENE_MESH mesh,
+		bool bDrawBottom = true,
+		bool bDrawTop = true,
+		bool bDrawSides = true);
+	// draw the shapes of each render pass
+	void RenderOpaqueObjects();
+	void RenderTransparentObjects();
 	// find a loaded texture by tag
-	int FindTextureID(std::string tag);
-	int FindTextureSlot(std::string tag);
+	int FindTextureID(const char* tag);
+	int FindTextureSlot(const char* tag);
 	// find a defined material by tag
-	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
+	bool FindMaterial(const char* tag, OBJECT_MATERIAL& material);
 
+	// build the model matrix for the transformation values
+	static glm::mat4 ComposeModelMatrix(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
 	// set the transformation values 
 	// into the transform buffer
 	void SetTransformations(
@@ -95,7 +207,7 @@ private:
 
 	// set the texture data into the shader
 	void SetShaderTexture(
-		std::string textureTag);
+		const char* textureTag);
 
 	// set the UV scale for the texture mapping
 	void SetTextureUVScale(
@@ -103,5 +215,16 @@ private:
 
 	// set the object material into the shader
 	void SetShaderMaterial(
-		std::string materialTag);
+		const char* materialTag);
+
+	// add uniform uploads to the counters for the current frame
+	void CountUniformUpload(size_t bytes, unsigned int count = 1);
+
+	// send uniform values that differ from the cached state
+	void ApplyModelValue(const glm::mat4& model);
+	void ApplyUseTextureValue(bool bUseTexture);
+	void ApplyTextureSlotValue(int textureSlot);
+	void ApplyColorValue(const glm::vec4& color);
+	void ApplyUVScaleValue(const glm::vec2& uvScale);
+	void ApplyMaterialValue(const OBJECT_MATERIAL& material);
 };
@@ -10,7 +10,14 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/transform.hpp>
 #include <glm/gtc/type_ptr.hpp>    
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <utility>
 
 // declaration of the global variables and defines
 namespace
@@ -20,8 +27,113 @@ namespace
 	const char* g_ViewName = "view";
 	const char* g_ProjectionName = "projection";
 
+	// GPU time budget for rendering the scene, leaving some
+	// headroom below a 60 frames per second frame time
+	const float GPU_FRAME_BUDGET_MS = 14.0f;
+	// lowest fraction of the window resolution to render at
+	const float MIN_RENDER_SCALE = 0.5f;
+	// seconds the camera moves each frame of a camera path replay
+	const float REPLAY_TIMESTEP = 1.0f / 60.0f;
+	// fraction of the way to move toward the ideal scale each
+	// frame, so the resolution settles instead of oscillating
+	const float RENDER_SCALE_SMOOTHING = 0.1f;
+
 	Camera* g_pCamera = nullptr;
 
+	// current size of the window framebuffer in pixels
+	int gWindowWidth = WINDOW_WIDTH;
+	int gWindowHeight = WINDOW_HEIGHT;
+
+	// rolling history of frame and GPU times for the performance
+	// HUD, with the GPU time of a frame in the same slot
+	const int FRAME_TIME_HISTORY = 120;
+	float gFrameTimes[FRAME_TIME_HISTORY] = {};
+	float gGpuTimes[FRAME_TIME_HISTORY] = {};
+	int gFrameTimeIndex = 0;
+	// seconds between refreshes of the HUD text
+	const double HUD_UPDATE_INTERVAL = 0.25;
+	// whether the HUD toggle key was down last frame
+	bool gHUDKeyWasDown = false;
+	// whether the capture keys were down last frame
+	bool gRecordKeyWasDown = false;
+	bool gScreenshotKeyWasDown = false;
+
+	// layout of the performance HUD in window pixels
+	const float HUD_MARGIN = 10.0f;
+	const float HUD_PADDING = 8.0f;
+	const float HUD_BAR_WIDTH = 2.0f;
+	const float HUD_GRAPH_HEIGHT = 48.0f;
+	// window pixels for each pixel of the 3x5 HUD font, and the
+	// spacing of its characters and lines
+	const float HUD_FONT_SCALE = 2.0f;
+	const float HUD_CHARACTER_WIDTH = 4.0f * HUD_FONT_SCALE;
+	const float HUD_LINE_HEIGHT = 7.0f * HUD_FONT_SCALE;
+	const int HUD_TEXT_COLUMNS = 36;
+	const int HUD_TEXT_LINES = 6;
+	// frame time at the top of the HUD graphs, and the frame
+	// time for 60 frames per second marked on them
+	const float HUD_GRAPH_MAX_MS = 1000.0f / 30.0f;
+	const float HUD_FRAME_BUDGET_MS = 1000.0f / 60.0f;
+
+	// colors of the performance HUD
+	const unsigned char HUD_PANEL_COLOR[4] = { 16, 16, 20, 255 };
+	const unsigned char HUD_GRAPH_COLOR[4] = { 40, 40, 48, 255 };
+	const unsigned char HUD_TEXT_COLOR[4] = { 230, 230, 230, 255 };
+	const unsigned char HUD_FRAME_COLOR[4] = { 80, 200, 90, 255 };
+	const unsigned char HUD_GPU_COLOR[4] = { 80, 150, 230, 255 };
+	const unsigned char HUD_SLOW_COLOR[4] = { 230, 70, 60, 255 };
+	const unsigned char HUD_BUDGET_COLOR[4] = { 230, 200, 60, 255 };
+
+	// the HUD is drawn from one batch of colored triangles, each
+	// vertex placed in window pixels from the top left corner
+	struct HUD_VERTEX
+	{
+		float x;
+		float y;
+		unsigned char color[4];
+	};
+	const int HUD_MAX_QUADS = 2048;
+	HUD_VERTEX gHUDVertices[HUD_MAX_QUADS * 6];
+	int gHUDVertexCount = 0;
+
+	// 3x5 pixel font for the HUD text, each row top to bottom
+	// with the value 4 for the left column and 1 for the right
+	const char g_HUDFontCharacters[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ.%()-:/";
+	const unsigned char g_HUDFont[][5] = {
+		{ 7, 5, 5, 5, 7 }, { 2, 6, 2, 2, 7 }, { 7, 1, 7, 4, 7 }, { 7, 1, 7, 1, 7 },
+		{ 5, 5, 7, 1, 1 }, { 7, 4, 7, 1, 7 }, { 7, 4, 7, 5, 7 }, { 7, 1, 1, 1, 1 },
+		{ 7, 5, 7, 5, 7 }, { 7, 5, 7, 1, 7 },
+		{ 2, 5, 7, 5, 5 }, { 6, 5, 6, 5, 6 }, { 3, 4, 4, 4, 3 }, { 6, 5, 5, 5, 6 },
+		{ 7, 4, 6, 4, 7 }, { 7, 4, 6, 4, 4 }, { 3, 4, 5, 5, 3 }, { 5, 5, 7, 5, 5 },
+		{ 7, 2, 2, 2, 7 }, { 1, 1, 1, 5, 2 }, { 5, 5, 6, 5, 5 }, { 4, 4, 4, 4, 7 },
+		{ 5, 7, 7, 5, 5 }, { 6, 5, 5, 5, 5 }, { 2, 5, 5, 5, 2 }, { 6, 5, 6, 4, 4 },
+		{ 2, 5, 5, 6, 3 }, { 6, 5, 6, 5, 5 }, { 3, 4, 2, 1, 6 }, { 7, 2, 2, 2, 2 },
+		{ 5, 5, 5, 5, 7 }, { 5, 5, 5, 5, 2 }, { 5, 5, 7, 7, 5 }, { 5, 5, 2, 5, 5 },
+		{ 5, 5, 2, 2, 2 }, { 7, 1, 2, 4, 7 },
+		{ 0, 0, 0, 0, 2 }, { 5, 1, 2, 4, 5 }, { 1, 2, 2, 2, 1 }, { 4, 2, 2, 2, 4 },
+		{ 0, 0, 7, 0, 0 }, { 0, 2, 0, 2, 0 }, { 1, 1, 2, 4, 4 } };
+
+	// shaders of the HUD, which only pass the vertex colors through
+	const char* g_HUDVertexShaderSource =
+		"#version 330 core\n"
+		"layout(location = 0) in vec2 position;\n"
+		"layout(location = 1) in vec4 color;\n"
+		"uniform vec2 windowSize;\n"
+		"out vec4 vertexColor;\n"
+		"void main()\n"
+		"{\n"
+		"	gl_Position = vec4(position.x / windowSize.x * 2.0 - 1.0, 1.0 - position.y / windowSize.y * 2.0, 0.0, 1.0);\n"
+		"	vertexColor = color;\n"
+		"}\n";
+	const char* g_HUDFragmentShaderSource =
+		"#version 330 core\n"
+		"in vec4 vertexColor;\n"
+		"out vec4 fragmentColor;\n"
+		"void main()\n"
+		"{\n"
+		"	fragmentColor = vertexColor;\n"
+		"}\n";
+
 	float gLastX = WINDOW_WIDTH / 2.0f;
 	float gLastY = WINDOW_HEIGHT / 2.0f;
 	bool gFirstMouse = true;
@@ -30,6 +142,144 @@ namespace
 	float gLastFrame = 0.0f;
 
 	bool bOrthographicProjection = false;
+
+	// whether the camera is driven by a replay instead of input
+	bool gReplayingCamera = false;
+
+	/***********************************************************
+	 *  AddHUDQuad()
+	 *
+	 *  Add a filled rectangle to the HUD batch, as two
+	 *  triangles.  Rectangles past the end of the batch are
+	 *  dropped.
+	 ***********************************************************/
+	void AddHUDQuad(float x, float y, float width, float height, const unsigned char color[4])
+	{
+		if (gHUDVertexCount + 6 > HUD_MAX_QUADS * 6)
+		{
+			return;
+		}
+
+		const float corners[6][2] = {
+			{ x, y }, { x, y + height }, { x + width, y + height },
+			{ x, y }, { x + width, y + height }, { x + width, y } };
+		for (int i = 0; i < 6; i++)
+		{
+			HUD_VERTEX& vertex = gHUDVertices[gHUDVertexCount++];
+			vertex.x = corners[i][0];
+			vertex.y = corners[i][1];
+			memcpy(vertex.color, color, sizeof(vertex.color));
+		}
+	}
+
+	/***********************************************************
+	 *  AddHUDText()
+	 *
+	 *  Add the passed in text to the HUD batch with the 3x5
+	 *  pixel font, one rectangle for each run of lit pixels
+	 *  in a row.  Lowercase letters are drawn as uppercase,
+	 *  and characters not in the font as spaces.
+	 ***********************************************************/
+	void AddHUDText(float x, float y, const char* text, const unsigned char color[4])
+	{
+		float lineStart = x;
+		for (const char* pCharacter = text; *pCharacter != '\0'; pCharacter++)
+		{
+			if (*pCharacter == '\n')
+			{
+				x = lineStart;
+				y += HUD_LINE_HEIGHT;
+				continue;
+			}
+
+			const char* pFound = strchr(g_HUDFontCharacters, toupper((unsigned char)*pCharacter));
+			if (pFound != NULL)
+			{
+				const unsigned char* rows = g_HUDFont[pFound - g_HUDFontCharacters];
+				for (int row = 0; row < 5; row++)
+				{
+					int column = 0;
+					while (column < 3)
+					{
+						if ((rows[row] & (4 >> column)) == 0)
+						{
+							column++;
+							continue;
+						}
+						int runStart = column;
+						while ((column < 3) && ((rows[row] & (4 >> column)) != 0))
+						{
+							column++;
+						}
+						AddHUDQuad(
+							x + runStart * HUD_FONT_SCALE,
+							y + row * HUD_FONT_SCALE,
+							(column - runStart) * HUD_FONT_SCALE,
+							HUD_FONT_SCALE,
+							color);
+					}
+				}
+			}
+			x += HUD_CHARACTER_WIDTH;
+		}
+	}
+
+	/***********************************************************
+	 *  AddHUDGraph()
+	 *
+	 *  Add a bar graph of the passed in time history to the HUD
+	 *  batch, oldest frame on the left.  Bars over the budget
+	 *  are drawn in the slow color, and a line marks the frame
+	 *  time for 60 frames per second.
+	 ***********************************************************/
+	void AddHUDGraph(float x, float y, const float* times, float budget, const unsigned char color[4])
+	{
+		AddHUDQuad(x, y, FRAME_TIME_HISTORY * HUD_BAR_WIDTH, HUD_GRAPH_HEIGHT, HUD_GRAPH_COLOR);
+
+		for (int i = 0; i < FRAME_TIME_HISTORY; i++)
+		{
+			float time = times[(gFrameTimeIndex + i) % FRAME_TIME_HISTORY];
+			float height = std::min(1.0f, time / HUD_GRAPH_MAX_MS) * HUD_GRAPH_HEIGHT;
+			if (height > 0.0f)
+			{
+				AddHUDQuad(
+					x + i * HUD_BAR_WIDTH,
+					y + HUD_GRAPH_HEIGHT - height,
+					HUD_BAR_WIDTH,
+					height,
+					(time > budget) ? HUD_SLOW_COLOR : color);
+			}
+		}
+
+		float budgetY = y + HUD_GRAPH_HEIGHT * (1.0f - HUD_FRAME_BUDGET_MS / HUD_GRAPH_MAX_MS);
+		AddHUDQuad(x, budgetY, FRAME_TIME_HISTORY * HUD_BAR_WIDTH, 1.0f, HUD_BUDGET_COLOR);
+	}
+
+	/***********************************************************
+	 *  CompileHUDShader()
+	 *
+	 *  Compile one shader of the HUD program, returning 0 with
+	 *  the compile log printed if it fails.
+	 ***********************************************************/
+	GLuint CompileHUDShader(GLenum type, const char* source)
+	{
+		GLuint shader = glCreateShader(type);
+		glShaderSource(shader, 1, &source, NULL);
+		glCompileShader(shader);
+
+		GLint bCompiled = GL_FALSE;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &bCompiled);
+		if (bCompiled == GL_FALSE)
+		{
+			char log[512];
+			glGetShaderInfoLog(shader, sizeof(log), NULL, log);
+			std::cout << "Performance HUD shader failed to compile: " << log << std::endl;
+			glDeleteShader(shader);
+			return(0);
+		}
+
+		return(shader);
+	}
 }
 
 /***********************************************************
@@ -39,6 +289,27 @@ ViewManager::ViewManager(ShaderManager* pShaderManager)
 {
 	m_pShaderManager = pShaderManager;
 	m_pWindow = NULL;
+	m_bShowPerformanceHUD = false;
+	m_lastHUDUpdate = 0.0;
+	m_gpuMilliseconds = 0.0f;
+	m_hudText[0] = '\0';
+	m_hudWindowSizeLocation = -1;
+	m_bHUDFailed = false;
+	m_renderTargetWidth = 0;
+	m_renderTargetHeight = 0;
+	m_renderWidth = WINDOW_WIDTH;
+	m_renderHeight = WINDOW_HEIGHT;
+	m_renderScale = 1.0f;
+	m_bRenderTargetFailed = false;
+	m_frameCount = 0;
+	m_recordStartTime = -1.0;
+	m_replayTime = 0.0;
+	m_replayFrames = 0;
+	m_replayFrameTimeTotal = 0.0;
+	m_replayFrameTimeMin = 0.0f;
+	m_replayFrameTimeMax = 0.0f;
+	m_replayGpuTimeTotal = 0.0;
+
 	g_pCamera = new Camera();
 	g_pCamera->Position = glm::vec3(0.0f, 10.0f, 7.0f);      // move camera up and forward
 	g_pCamera->Front = glm::normalize(glm::vec3(0.0f, -1.0f, -1.0f)); // look downward toward bowl
@@ -84,8 +355,10 @@ GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
 	// Add mouse scroll callback for zoom/speed
 	glfwSetScrollCallback(window, &ViewManager::Mouse_Scroll_Callback);
 
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	// track the framebuffer size, which can differ from the
+	// requested window size on high DPI displays
+	glfwSetFramebufferSizeCallback(window, &ViewManager::Framebuffer_Size_Callback);
+	glfwGetFramebufferSize(window, &gWindowWidth, &gWindowHeight);
 
 	m_pWindow = window;
 
@@ -110,7 +383,7 @@ void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos,
 	gLastX = xMousePos;
 	gLastY = yMousePos;
 
-	if (g_pCamera)
+	if (g_pCamera && (gReplayingCamera == false))
 		g_pCamera->ProcessMouseMovement(xOffset, yOffset);
 }
 
@@ -119,10 +392,24 @@ void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos,
  ***********************************************************/
 void ViewManager::Mouse_Scroll_Callback(GLFWwindow* window, double xoffset, double yoffset)
 {
-	if (g_pCamera)
+	if (g_pCamera && (gReplayingCamera == false))
 		g_pCamera->ProcessMouseScroll((float)yoffset);
 }
 
+/***********************************************************
+ *  Framebuffer_Size_Callback()
+ ***********************************************************/
+void ViewManager::Framebuffer_Size_Callback(GLFWwindow* window, int width, int height)
+{
+	// a minimized window reports a zero size, so keep the
+	// last usable size until the window is restored
+	if ((width > 0) && (height > 0))
+	{
+		gWindowWidth = width;
+		gWindowHeight = height;
+	}
+}
+
 /***********************************************************
  *  ProcessKeyboardEvents()
  ***********************************************************/
@@ -134,7 +421,7 @@ void ViewManager::ProcessKeyboardEvents()
 	}
 
 	// Camera WASDQE controls
-	if (g_pCamera)
+	if (g_pCamera && (gReplayingCamera == false))
 	{
 		if (glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS)
 			g_pCamera->ProcessKeyboard(FORWARD, gDeltaTime);
@@ -150,6 +437,37 @@ void ViewManager::ProcessKeyboardEvents()
 			g_pCamera->ProcessKeyboard(DOWN, gDeltaTime);
 	}
 
+	// Performance HUD toggle, only on the frame the key goes down
+	bool bHUDKeyDown = (glfwGetKey(m_pWindow, GLFW_KEY_F1) == GLFW_PRESS);
+	if (bHUDKeyDown && (gHUDKeyWasDown == false))
+	{
+		m_bShowPerformanceHUD = !m_bShowPerformanceHUD;
+		m_lastHUDUpdate = 0.0;
+	}
+	gHUDKeyWasDown = bHUDKeyDown;
+
+	// Frame recording toggle and screenshot, on the frame the key goes down
+	bool bRecordKeyDown = (glfwGetKey(m_pWindow, GLFW_KEY_F3) == GLFW_PRESS);
+	if (bRecordKeyDown && (gRecordKeyWasDown == false))
+	{
+		if (m_frameCapture.IsRecording())
+		{
+			m_frameCapture.StopRecording();
+		}
+		else
+		{
+			m_frameCapture.StartRecording();
+		}
+	}
+	gRecordKeyWasDown = bRecordKeyDown;
+
+	bool bScreenshotKeyDown = (glfwGetKey(m_pWindow, GLFW_KEY_F12) == GLFW_PRESS);
+	if (bScreenshotKeyDown && (gScreenshotKeyWasDown == false))
+	{
+		m_frameCapture.CaptureScreenshot();
+	}
+	gScreenshotKeyWasDown = bScreenshotKeyDown;
+
 	// Perspective/Orthographic toggle
 	if (glfwGetKey(m_pWindow, GLFW_KEY_P) == GLFW_PRESS)
 		bOrthographicProjection = false;
@@ -168,6 +486,112 @@ void ViewManager::ProcessKeyboardEvents()
 	*/
 }
 
+/***********************************************************
+ *  UpdateRenderScale()
+ *
+ *  Adjust the fraction of the window resolution that is
+ *  rendered so the GPU time for the scene stays within the
+ *  frame budget.  Timer results are read from a query issued
+ *  several frames ago, so reading them never stalls.
+ ***********************************************************/
+void ViewManager::UpdateRenderScale()
+{
+	if ((m_gpuTimerQueries[0].IsValid() == false) || (m_frameCount < GPU_TIMER_QUERIES))
+	{
+		return;
+	}
+
+	GLuint query = m_gpuTimerQueries[m_frameCount % GPU_TIMER_QUERIES].Get();
+	GLint bAvailable = 0;
+	glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &bAvailable);
+	if (bAvailable == 0)
+	{
+		return;
+	}
+
+	GLuint64 elapsedNanoseconds = 0;
+	glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNanoseconds);
+	float gpuMilliseconds = (float)elapsedNanoseconds / 1000000.0f;
+	m_gpuMilliseconds = gpuMilliseconds;
+
+	// a replay keeps the full resolution so its frames repeat
+	if ((gpuMilliseconds <= 0.0f) || gReplayingCamera)
+	{
+		return;
+	}
+
+	// the rendering cost follows the number of pixels, which
+	// changes with the square of the render scale
+	float idealScale = m_renderScale * std::sqrt(GPU_FRAME_BUDGET_MS / gpuMilliseconds);
+	idealScale = std::min(1.0f, std::max(MIN_RENDER_SCALE, idealScale));
+
+	m_renderScale += (idealScale - m_renderScale) * RENDER_SCALE_SMOOTHING;
+}
+
+/***********************************************************
+ *  UpdateRenderTarget()
+ *
+ *  Create the offscreen render target at the full window
+ *  size, or resize it after the window changes.  The scene
+ *  is rendered into the lower-left part of the target, so
+ *  changing the render scale never reallocates it.
+ ***********************************************************/
+void ViewManager::UpdateRenderTarget()
+{
+	if (m_gpuTimerQueries[0].IsValid() == false)
+	{
+		for (int i = 0; i < GPU_TIMER_QUERIES; i++)
+		{
+			m_gpuTimerQueries[i] = GpuResource::Create(GpuResource::QUERY);
+		}
+	}
+
+	if (m_bRenderTargetFailed)
+	{
+		return;
+	}
+
+	if ((m_renderTargetWidth != gWindowWidth) || (m_renderTargetHeight != gWindowHeight))
+	{
+		if (m_renderFramebuffer.IsValid() == false)
+		{
+			m_renderFramebuffer = GpuResource::Create(GpuResource::FRAMEBUFFER);
+			m_colorRenderbuffer = GpuResource::Create(GpuResource::RENDERBUFFER);
+			m_depthRenderbuffer = GpuResource::Create(GpuResource::RENDERBUFFER);
+		}
+
+		// both formats use four bytes per pixel
+		size_t renderbufferBytes = (size_t)gWindowWidth * gWindowHeight * 4;
+		glBindRenderbuffer(GL_RENDERBUFFER, m_colorRenderbuffer.Get());
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, gWindowWidth, gWindowHeight);
+		m_colorRenderbuffer.SetMemorySize(renderbufferBytes);
+		glBindRenderbuffer(GL_RENDERBUFFER, m_depthRenderbuffer.Get());
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, gWindowWidth, gWindowHeight);
+		m_depthRenderbuffer.SetMemorySize(renderbufferBytes);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_renderFramebuffer.Get());
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorRenderbuffer.Get());
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthRenderbuffer.Get());
+		GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		if (status != GL_FRAMEBUFFER_COMPLETE)
+		{
+			// fall back to rendering straight into the window
+			std::cout << "Offscreen render target is incomplete, dynamic resolution is disabled" << std::endl;
+			m_renderFramebuffer.Reset();
+			m_colorRenderbuffer.Reset();
+			m_depthRenderbuffer.Reset();
+			m_bRenderTargetFailed = true;
+			return;
+		}
+
+		m_renderTargetWidth = gWindowWidth;
+		m_renderTargetHeight = gWindowHeight;
+	}
+}
+
 /***********************************************************
  *  PrepareSceneView()
  ***********************************************************/
@@ -176,13 +600,39 @@ void ViewManager::PrepareSceneView()
 	glm::mat4 view;
 	glm::mat4 projection;
 
-	// per-frame timing
+	// per-frame timing, with the camera moved by a fixed
+	// timestep during a replay whatever the frame rate
 	float currentFrame = glfwGetTime();
-	gDeltaTime = currentFrame - gLastFrame;
+	float frameTime = currentFrame - gLastFrame;
 	gLastFrame = currentFrame;
+	gDeltaTime = gReplayingCamera ? REPLAY_TIMESTEP : frameTime;
+	gFrameTimes[gFrameTimeIndex] = frameTime * 1000.0f;
+	gFrameTimeIndex = (gFrameTimeIndex + 1) % FRAME_TIME_HISTORY;
+
+	// pick the render resolution for this frame and bind the
+	// offscreen target, or the window if it is not available
+	UpdateRenderScale();
+	gGpuTimes[(gFrameTimeIndex + FRAME_TIME_HISTORY - 1) % FRAME_TIME_HISTORY] = m_gpuMilliseconds;
+	UpdateRenderTarget();
+	if (m_renderFramebuffer.IsValid())
+	{
+		m_renderWidth = std::max(1, (int)(gWindowWidth * m_renderScale));
+		m_renderHeight = std::max(1, (int)(gWindowHeight * m_renderScale));
+		glBindFramebuffer(GL_FRAMEBUFFER, m_renderFramebuffer.Get());
+	}
+	else
+	{
+		m_renderWidth = gWindowWidth;
+		m_renderHeight = gWindowHeight;
+	}
+	glViewport(0, 0, m_renderWidth, m_renderHeight);
+
+	// time the scene rendering on the GPU
+	glBeginQuery(GL_TIME_ELAPSED, m_gpuTimerQueries[m_frameCount % GPU_TIMER_QUERIES].Get());
 
 	// process any keyboard events that may be waiting in the event queue
 	ProcessKeyboardEvents();
+	UpdateCameraPath(frameTime);
 
 	// get the current view matrix from the camera
 	view = g_pCamera->GetViewMatrix();
@@ -191,12 +641,12 @@ void ViewManager::PrepareSceneView()
 	if (bOrthographicProjection)
 	{
 		float orthoSize = 10.0f;
-		float aspect = (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT;
+		float aspect = (float)gWindowWidth / (float)gWindowHeight;
 		projection = glm::ortho(-orthoSize * aspect, orthoSize * aspect, -orthoSize, orthoSize, 0.1f, 100.0f);
 	}
 	else
 	{
-		projection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
+		projection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)gWindowWidth / (GLfloat)gWindowHeight, 0.1f, 100.0f);
 	}
 
 	if (NULL != m_pShaderManager)
@@ -206,3 +656,324 @@ void ViewManager::PrepareSceneView()
 		m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
 	}
 }
+
+/***********************************************************
+ *  StartCameraRecording()
+ *
+ *  Start saving the camera state of every frame to the
+ *  passed in camera path file.  The recording time starts at
+ *  the first rendered frame, not at the time of this call.
+ ***********************************************************/
+bool ViewManager::StartCameraRecording(const char* filename)
+{
+	if (m_cameraPath.StartRecording(filename) == false)
+	{
+		return(false);
+	}
+
+	m_recordStartTime = -1.0;
+	return(true);
+}
+
+/***********************************************************
+ *  StartCameraReplay()
+ *
+ *  Load a recorded camera path to drive the camera in place
+ *  of the mouse and keyboard.  The render scale is fixed at
+ *  full resolution so that each run renders the same frames.
+ ***********************************************************/
+bool ViewManager::StartCameraReplay(const char* filename)
+{
+	if (m_cameraPath.LoadReplay(filename) == false)
+	{
+		return(false);
+	}
+
+	gReplayingCamera = true;
+	m_renderScale = 1.0f;
+	m_replayTime = 0.0;
+	m_replayFrames = 0;
+	m_replayFrameTimeTotal = 0.0;
+	m_replayFrameTimeMin = 0.0f;
+	m_replayFrameTimeMax = 0.0f;
+	m_replayGpuTimeTotal = 0.0;
+	return(true);
+}
+
+/***********************************************************
+ *  UpdateCameraPath()
+ *
+ *  Save the camera state of this frame when recording, or
+ *  set the camera to the state for this frame of a replay.
+ *  The replay ends with a report of the measured frame
+ *  times, and the window is closed so that benchmark runs
+ *  can be scripted.
+ ***********************************************************/
+void ViewManager::UpdateCameraPath(float frameTime)
+{
+	if (g_pCamera == nullptr)
+	{
+		return;
+	}
+
+	if (m_cameraPath.IsRecording())
+	{
+		CameraPath::CAMERA_STATE state;
+		state.position = g_pCamera->Position;
+		state.front = g_pCamera->Front;
+		state.up = g_pCamera->Up;
+		state.zoom = g_pCamera->Zoom;
+		state.bOrthographic = bOrthographicProjection;
+		double currentTime = glfwGetTime();
+		if (m_recordStartTime < 0.0)
+		{
+			m_recordStartTime = currentTime;
+		}
+		m_cameraPath.RecordState(currentTime - m_recordStartTime, state);
+	}
+
+	if (m_cameraPath.IsReplaying() == false)
+	{
+		return;
+	}
+
+	CameraPath::CAMERA_STATE state;
+	if (m_cameraPath.GetReplayState(m_replayTime, state))
+	{
+		g_pCamera->Position = state.position;
+		g_pCamera->Front = state.front;
+		g_pCamera->Up = state.up;
+		g_pCamera->Zoom = state.zoom;
+		bOrthographicProjection = state.bOrthographic;
+		m_replayTime += REPLAY_TIMESTEP;
+
+		// the first frame time includes the application startup
+		if (m_replayTime > REPLAY_TIMESTEP)
+		{
+			float frameMilliseconds = frameTime * 1000.0f;
+			if ((m_replayFrames == 0) || (frameMilliseconds < m_replayFrameTimeMin))
+				m_replayFrameTimeMin = frameMilliseconds;
+			if ((m_replayFrames == 0) || (frameMilliseconds > m_replayFrameTimeMax))
+				m_replayFrameTimeMax = frameMilliseconds;
+			m_replayFrameTimeTotal += frameMilliseconds;
+			m_replayGpuTimeTotal += m_gpuMilliseconds;
+			m_replayFrames++;
+		}
+		return;
+	}
+
+	if (m_replayFrames > 0)
+	{
+		std::cout << "Camera path replay finished: " << m_replayFrames << " frames,"
+			<< " frame time avg " << (m_replayFrameTimeTotal / m_replayFrames) << " ms,"
+			<< " min " << m_replayFrameTimeMin << " ms,"
+			<< " max " << m_replayFrameTimeMax << " ms,"
+			<< " GPU time avg " << (m_replayGpuTimeTotal / m_replayFrames) << " ms" << std::endl;
+	}
+
+	m_cameraPath.StopReplay();
+	gReplayingCamera = false;
+	if (m_pWindow != NULL)
+	{
+		glfwSetWindowShouldClose(m_pWindow, true);
+	}
+}
+
+/***********************************************************
+ *  PresentSceneView()
+ *
+ *  Stop timing the scene and upscale the rendered part of
+ *  the offscreen target to fill the display window, then
+ *  start the capture of the window image if requested.
+ ***********************************************************/
+void ViewManager::PresentSceneView()
+{
+	glEndQuery(GL_TIME_ELAPSED);
+	m_frameCount++;
+
+	if (m_renderFramebuffer.IsValid())
+	{
+		GLenum filter = GL_LINEAR;
+		if ((m_renderWidth == gWindowWidth) && (m_renderHeight == gWindowHeight))
+		{
+			filter = GL_NEAREST;
+		}
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_renderFramebuffer.Get());
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(
+			0, 0, m_renderWidth, m_renderHeight,
+			0, 0, gWindowWidth, gWindowHeight,
+			GL_COLOR_BUFFER_BIT, filter);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	// read back the finished window image when capturing
+	m_frameCapture.CaptureFrame(gWindowWidth, gWindowHeight);
+}
+
+/***********************************************************
+ *  UpdatePerformanceHUD()
+ *
+ *  Draw the performance HUD over the top left corner of the
+ *  window, with graphs of the recent frame and GPU times
+ *  above the frame counters.  The counter text is refreshed a
+ *  few times a second so it can be read.  The HUD is drawn
+ *  after the frame capture, so it is not in the image files.
+ ***********************************************************/
+void ViewManager::UpdatePerformanceHUD(const FRAME_STATS& stats)
+{
+	if ((m_bShowPerformanceHUD == false) || (m_pWindow == NULL))
+	{
+		return;
+	}
+
+	double currentTime = glfwGetTime();
+	if (currentTime - m_lastHUDUpdate >= HUD_UPDATE_INTERVAL)
+	{
+		m_lastHUDUpdate = currentTime;
+
+		float totalTime = 0.0f;
+		float maxTime = 0.0f;
+		for (int i = 0; i < FRAME_TIME_HISTORY; i++)
+		{
+			totalTime += gFrameTimes[i];
+			maxTime = std::max(maxTime, gFrameTimes[i]);
+		}
+		float averageTime = totalTime / FRAME_TIME_HISTORY;
+		float lastTime = gFrameTimes[(gFrameTimeIndex + FRAME_TIME_HISTORY - 1) % FRAME_TIME_HISTORY];
+
+		snprintf(m_hudText, sizeof(m_hudText),
+			"FRAME %.2f MS AVG %.2f MAX %.2f\n"
+			"GPU %.2f MS AT %d%% SCALE\n"
+			"DRAWS %u TEXTURES %u\n"
+			"UNIFORMS %u (%.1f KB)\n"
+			"UNIFORMS FILTERED %u\n"
+			"GPU MEMORY %.1f MB",
+			lastTime,
+			averageTime,
+			maxTime,
+			m_gpuMilliseconds,
+			(int)(m_renderScale * 100.0f + 0.5f),
+			stats.drawCalls,
+			stats.textureChanges,
+			stats.uniformUploads,
+			stats.uniformBytes / 1024.0f,
+			stats.uniformUploadsFiltered,
+			GpuResource::GetTotalMemoryUsed() / (1024.0f * 1024.0f));
+	}
+
+	DrawPerformanceHUD();
+}
+
+/***********************************************************
+ *  CreateHUDResources()
+ *
+ *  Build the shader program of the HUD from its embedded
+ *  source, and the vertex buffer its batch is streamed into.
+ *  A failure is only reported once, and leaves the HUD off.
+ ***********************************************************/
+bool ViewManager::CreateHUDResources()
+{
+	GLuint vertexShader = CompileHUDShader(GL_VERTEX_SHADER, g_HUDVertexShaderSource);
+	GLuint fragmentShader = CompileHUDShader(GL_FRAGMENT_SHADER, g_HUDFragmentShaderSource);
+
+	GpuResource program = GpuResource::Create(GpuResource::PROGRAM);
+	GLint bLinked = GL_FALSE;
+	if ((vertexShader != 0) && (fragmentShader != 0))
+	{
+		glAttachShader(program.Get(), vertexShader);
+		glAttachShader(program.Get(), fragmentShader);
+		glLinkProgram(program.Get());
+		glGetProgramiv(program.Get(), GL_LINK_STATUS, &bLinked);
+		if (bLinked == GL_FALSE)
+		{
+			char log[512];
+			glGetProgramInfoLog(program.Get(), sizeof(log), NULL, log);
+			std::cout << "Performance HUD shader program failed to link: " << log << std::endl;
+		}
+		glDetachShader(program.Get(), vertexShader);
+		glDetachShader(program.Get(), fragmentShader);
+	}
+	// the linked program keeps its own copy of the shaders
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+
+	if (bLinked == GL_FALSE)
+	{
+		m_bHUDFailed = true;
+		return(false);
+	}
+
+	m_hudProgram = std::move(program);
+	m_hudWindowSizeLocation = glGetUniformLocation(m_hudProgram.Get(), "windowSize");
+
+	m_hudVertexArray = GpuResource::Create(GpuResource::VERTEX_ARRAY);
+	m_hudVertexBuffer = GpuResource::Create(GpuResource::BUFFER);
+	glBindVertexArray(m_hudVertexArray.Get());
+	glBindBuffer(GL_ARRAY_BUFFER, m_hudVertexBuffer.Get());
+	glBufferData(GL_ARRAY_BUFFER, sizeof(gHUDVertices), NULL, GL_STREAM_DRAW);
+	m_hudVertexBuffer.SetMemorySize(sizeof(gHUDVertices));
+
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(HUD_VERTEX), (void*)offsetof(HUD_VERTEX, x));
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(HUD_VERTEX), (void*)offsetof(HUD_VERTEX, color));
+	glEnableVertexAttribArray(1);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	return(true);
+}
+
+/***********************************************************
+ *  DrawPerformanceHUD()
+ *
+ *  Build the HUD panel, graphs and text into one vertex
+ *  batch and draw it with a single call, so the HUD adds one
+ *  draw and one buffer upload to the frame it measures.  The
+ *  scene shader program is bound again afterwards.
+ ***********************************************************/
+void ViewManager::DrawPerformanceHUD()
+{
+	if ((m_hudProgram.IsValid() == false) &&
+		(m_bHUDFailed || (CreateHUDResources() == false)))
+	{
+		return;
+	}
+
+	gHUDVertexCount = 0;
+
+	float graphWidth = FRAME_TIME_HISTORY * HUD_BAR_WIDTH;
+	float panelWidth = std::max(graphWidth, HUD_TEXT_COLUMNS * HUD_CHARACTER_WIDTH) + HUD_PADDING * 2.0f;
+	float panelHeight = (HUD_GRAPH_HEIGHT + HUD_PADDING) * 2.0f + HUD_TEXT_LINES * HUD_LINE_HEIGHT + HUD_PADDING;
+	AddHUDQuad(HUD_MARGIN, HUD_MARGIN, panelWidth, panelHeight, HUD_PANEL_COLOR);
+
+	float x = HUD_MARGIN + HUD_PADDING;
+	float y = HUD_MARGIN + HUD_PADDING;
+	AddHUDGraph(x, y, gFrameTimes, HUD_FRAME_BUDGET_MS, HUD_FRAME_COLOR);
+	y += HUD_GRAPH_HEIGHT + HUD_PADDING;
+	AddHUDGraph(x, y, gGpuTimes, GPU_FRAME_BUDGET_MS, HUD_GPU_COLOR);
+	y += HUD_GRAPH_HEIGHT + HUD_PADDING;
+	AddHUDText(x, y, m_hudText, HUD_TEXT_COLOR);
+
+	glViewport(0, 0, gWindowWidth, gWindowHeight);
+	glDisable(GL_DEPTH_TEST);
+	glUseProgram(m_hudProgram.Get());
+	glUniform2f(m_hudWindowSizeLocation, (float)gWindowWidth, (float)gWindowHeight);
+
+	// orphan the buffer so the upload does not wait for the GPU
+	// to finish drawing the batch of the previous frame
+	glBindVertexArray(m_hudVertexArray.Get());
+	glBindBuffer(GL_ARRAY_BUFFER, m_hudVertexBuffer.Get());
+	glBufferData(GL_ARRAY_BUFFER, sizeof(gHUDVertices), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, gHUDVertexCount * sizeof(HUD_VERTEX), gHUDVertices);
+	glDrawArrays(GL_TRIANGLES, 0, gHUDVertexCount);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glEnable(GL_DEPTH_TEST);
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->use();
+	}
+}
\ No newline at end of file
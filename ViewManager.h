@@ -9,6 +9,10 @@
 
 #pragma once
 
+#include "CameraPath.h"
+#include "FrameCapture.h"
+#include "FrameStats.h"
+#include "GpuResource.h"
 #include "ShaderManager.h"
 #include "camera.h"
 
@@ -30,14 +34,81 @@ public:
 	// mouse scroll callback for camera speed/zoom control
 	static void Mouse_Scroll_Callback(GLFWwindow* window, double xoffset, double yoffset);
 
+	// framebuffer size callback for window resizing
+	static void Framebuffer_Size_Callback(GLFWwindow* window, int width, int height);
+
 private:
+	// number of GPU timer queries cycled between frames
+	static const int GPU_TIMER_QUERIES = 3;
+	// characters of text shown on the performance HUD
+	static const int HUD_TEXT_SIZE = 320;
+
 	// pointer to shader manager object
 	ShaderManager* m_pShaderManager;
 	// active OpenGL display window
 	GLFWwindow* m_pWindow;
+	// whether the performance HUD is shown
+	bool m_bShowPerformanceHUD;
+	// time the HUD text was last refreshed
+	double m_lastHUDUpdate;
+	// last measured GPU time for the scene in milliseconds
+	float m_gpuMilliseconds;
+	// counter text of the performance HUD, one line per row
+	char m_hudText[HUD_TEXT_SIZE];
+	// shader program and vertex buffer for drawing the HUD
+	GpuResource m_hudProgram;
+	GpuResource m_hudVertexArray;
+	GpuResource m_hudVertexBuffer;
+	GLint m_hudWindowSizeLocation;
+	// set when the HUD shader program could not be built
+	bool m_bHUDFailed;
+
+	// offscreen render target for dynamic resolution scaling
+	GpuResource m_renderFramebuffer;
+	GpuResource m_colorRenderbuffer;
+	GpuResource m_depthRenderbuffer;
+	// allocated size of the offscreen render target
+	int m_renderTargetWidth;
+	int m_renderTargetHeight;
+	// scaled size rendered into the target this frame
+	int m_renderWidth;
+	int m_renderHeight;
+	// fraction of the window resolution that is rendered
+	float m_renderScale;
+	// set when the offscreen target could not be created
+	bool m_bRenderTargetFailed;
+	// GPU timer queries for measuring the scene rendering time
+	GpuResource m_gpuTimerQueries[GPU_TIMER_QUERIES];
+	// number of frames rendered so far
+	unsigned int m_frameCount;
+	// screenshots and recordings of the displayed frames
+	FrameCapture m_frameCapture;
+	// camera path being recorded or replayed
+	CameraPath m_cameraPath;
+	// time of the first recorded frame, negative until then
+	double m_recordStartTime;
+	// position in the camera path replay in seconds
+	double m_replayTime;
+	// frame timings measured during the replay
+	unsigned int m_replayFrames;
+	double m_replayFrameTimeTotal;
+	float m_replayFrameTimeMin;
+	float m_replayFrameTimeMax;
+	double m_replayGpuTimeTotal;
 
 	// process keyboard events for interaction with the 3D scene
 	void ProcessKeyboardEvents();
+	// adjust the render scale from the measured GPU frame time
+	void UpdateRenderScale();
+	// create or resize the offscreen render target
+	void UpdateRenderTarget();
+	// record the camera state, or move the camera along the
+	// replayed path and report the timings at its end
+	void UpdateCameraPath(float frameTime);
+	// build the shader program and vertex buffer of the HUD
+	bool CreateHUDResources();
+	// draw the HUD graphs and text in a single batch
+	void DrawPerformanceHUD();
 
 public:
 	// create the initial OpenGL display window
@@ -45,4 +116,16 @@ public:
 
 	// prepare the conversion from 3D object display to 2D scene display
 	void PrepareSceneView();
+
+	// upscale the rendered scene into the display window
+	void PresentSceneView();
+
+	// draw the frame counters and timings on the performance HUD
+	void UpdatePerformanceHUD(const FRAME_STATS& stats);
+
+	// save the camera path of this session to a file
+	bool StartCameraRecording(const char* filename);
+	// move the camera along a recorded path at a fixed timestep,
+	// and close the window with a timing report at its end
+	bool StartCameraReplay(const char* filename);
 };